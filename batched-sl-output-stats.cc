@@ -0,0 +1,63 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "batched-sl-output-stats.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+
+#include <sstream>
+
+namespace ns3
+{
+
+const SlOutputSeedRun&
+SlOutputSeedRun::Get()
+{
+    static const SlOutputSeedRun seedRun{RngSeedManager::GetSeed(), RngSeedManager::GetRun()};
+    return seedRun;
+}
+
+static void
+SplitAddress(const Address& address, std::string& ip, uint16_t& port)
+{
+    std::ostringstream oss;
+    if (InetSocketAddress::IsMatchingType(address))
+    {
+        InetSocketAddress inet = InetSocketAddress::ConvertFrom(address);
+        oss << inet.GetIpv4();
+        port = inet.GetPort();
+    }
+    else if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        Inet6SocketAddress inet6 = Inet6SocketAddress::ConvertFrom(address);
+        oss << inet6.GetIpv6();
+        port = inet6.GetPort();
+    }
+    ip = oss.str();
+}
+
+PktTxRxRecord
+MakePktTxRxRecord(const std::string& txRx,
+                  uint32_t nodeId,
+                  uint64_t imsi,
+                  uint32_t pktSize,
+                  const Address& srcAddrs,
+                  const Address& dstAddrs,
+                  uint32_t seq)
+{
+    PktTxRxRecord record;
+    record.timeSec = Simulator::Now().GetSeconds();
+    record.txRx = txRx;
+    record.nodeId = nodeId;
+    record.imsi = imsi;
+    record.pktSize = pktSize;
+    SplitAddress(srcAddrs, record.srcIp, record.srcPort);
+    SplitAddress(dstAddrs, record.dstIp, record.dstPort);
+    record.pktSeqNum = seq;
+    return record;
+}
+
+} // namespace ns3
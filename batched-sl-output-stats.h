@@ -0,0 +1,133 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef BATCHED_SL_OUTPUT_STATS_H
+#define BATCHED_SL_OUTPUT_STATS_H
+
+#include "sl-output-records.h"
+#include "sqlite-batch-writer.h"
+
+#include "ns3/address.h"
+
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * Bind the columns of \p record, then SEED and RUN, to \p stmt.
+ * \param stmt "INSERT INTO table VALUES (?,...)"
+ * \param record the row
+ */
+template <typename Record>
+void
+BindRecord(sqlite3_stmt* stmt, const Record& record)
+{
+    int pos = 1;
+    auto bind = [stmt, &pos](const char*, const auto& value) {
+        using T = std::decay_t<decltype(value)>;
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            sqlite3_bind_double(stmt, pos++, value);
+        }
+        else if constexpr (std::is_arithmetic<T>::value)
+        {
+            sqlite3_bind_int64(stmt, pos++, static_cast<sqlite3_int64>(value));
+        }
+        else
+        {
+            sqlite3_bind_text(stmt, pos++, value.c_str(), value.size(), SQLITE_TRANSIENT);
+        }
+    };
+    RecordSchema<Record>::Visit(record, bind);
+    bind("SEED", SlOutputSeedRun::Get().seed);
+    bind("RUN", SlOutputSeedRun::Get().run);
+}
+
+/**
+ * \brief Bounded-memory replacement of the nr sidelink stats classes.
+ *
+ * Same tables and columns as UeMacPscchTxOutputStats,
+ * UeMacPsschTxOutputStats, UePhyPscchRxOutputStats, UePhyPsschRxOutputStats
+ * and UeToUePktTxRxOutputStats, but rows are flushed every \p batchSize
+ * rows, with one prepared statement reused for the whole batch inside a
+ * single transaction, instead of being cached until the end of the
+ * simulation. Pass a SqliteBatchWriter with a background thread to write
+ * the batches while the simulation runs.
+ */
+template <typename Record>
+class BatchedSlOutputStats : public SlRecordSink<Record>
+{
+  public:
+    /**
+     * Create the table, if needed, and delete the rows of the current seed
+     * and run, as the nr stats do.
+     * \param writer writer of the database
+     * \param tableName table name
+     * \param batchSize rows per transaction
+     */
+    void SetDb(Ptr<SqliteBatchWriter> writer, const std::string& tableName, uint32_t batchSize)
+    {
+        writer->Drain();
+        SQLiteOutput* db = writer->GetDb();
+        bool ret = db->SpinExec("CREATE TABLE IF NOT EXISTS " + tableName + " (" +
+                                SqlColumns<Record>() + ");");
+        NS_ABORT_MSG_UNLESS(ret, "Could not create table " << tableName);
+
+        sqlite3_stmt* stmt;
+        ret = db->SpinPrepare(&stmt, "DELETE FROM \"" + tableName + "\" WHERE SEED = ? AND RUN = ?;");
+        NS_ABORT_MSG_UNLESS(ret, "Could not prepare the deletion of old rows of " << tableName);
+        sqlite3_bind_int64(stmt, 1, SlOutputSeedRun::Get().seed);
+        sqlite3_bind_int64(stmt, 2, SlOutputSeedRun::Get().run);
+        ret = db->SpinExec(stmt);
+        NS_ABORT_MSG_UNLESS(ret, "Could not delete old rows of " << tableName);
+        SQLiteOutput::SpinFinalize(stmt);
+
+        std::string placeholders;
+        for (uint32_t i = 0; i < ColumnCount<Record>() + 2; ++i)
+        {
+            placeholders += (i == 0) ? "?" : ",?";
+        }
+        m_table.Open(writer,
+                     "INSERT INTO " + tableName + " VALUES (" + placeholders + ");",
+                     &BindRecord<Record>,
+                     batchSize);
+    }
+
+    /// \param record row to be written
+    void Save(const Record& record) override
+    {
+        m_table.Add(record);
+    }
+
+    /// Write the rows not flushed yet and wait for the writer.
+    void EmptyCache() override
+    {
+        m_table.EmptyCache();
+    }
+
+  private:
+    SqliteBatchTable<Record> m_table; //!< rows waiting to be written
+};
+
+typedef BatchedSlOutputStats<SlPscchUeMacStatParameters> BatchedUeMacPscchTxStats;
+typedef BatchedSlOutputStats<SlPsschUeMacStatParameters> BatchedUeMacPsschTxStats;
+typedef BatchedSlOutputStats<SlRxCtrlPacketTraceParams> BatchedUePhyPscchRxStats;
+typedef BatchedSlOutputStats<SlRxDataPacketTraceParams> BatchedUePhyPsschRxStats;
+typedef BatchedSlOutputStats<PktTxRxRecord> BatchedUeToUePktTxRxStats;
+
+/**
+ * Build the pktTxRx row of an application Tx/Rx trace, the same way
+ * UeToUePktTxRxOutputStats::Save does.
+ */
+PktTxRxRecord MakePktTxRxRecord(const std::string& txRx,
+                                uint32_t nodeId,
+                                uint64_t imsi,
+                                uint32_t pktSize,
+                                const Address& srcAddrs,
+                                const Address& dstAddrs,
+                                uint32_t seq);
+
+} // namespace ns3
+
+#endif /* BATCHED_SL_OUTPUT_STATS_H */
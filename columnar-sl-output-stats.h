@@ -0,0 +1,99 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef COLUMNAR_SL_OUTPUT_STATS_H
+#define COLUMNAR_SL_OUTPUT_STATS_H
+
+#include "columnar-table-writer.h"
+#include "sl-output-records.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \return the column type used for values of type T
+ */
+template <typename T>
+ColumnarTableWriter::ColumnType
+ColumnarTypeOf()
+{
+    if (std::is_floating_point<T>::value)
+    {
+        return ColumnarTableWriter::DOUBLE;
+    }
+    if (std::is_arithmetic<T>::value)
+    {
+        return ColumnarTableWriter::INT64;
+    }
+    return ColumnarTableWriter::STRING;
+}
+
+/**
+ * \brief Sidelink stats table written as a ColumnarTableWriter file.
+ *
+ * Same columns as the SQLite tables (RecordSchema, then SEED and RUN), one
+ * file per table.
+ */
+template <typename Record>
+class ColumnarSlOutputStats : public SlRecordSink<Record>
+{
+  public:
+    /**
+     * \param filename file of the table, overwritten
+     * \param rowGroupSize rows per row group
+     */
+    void Open(const std::string& filename, uint32_t rowGroupSize)
+    {
+        std::vector<std::string> names;
+        std::vector<ColumnarTableWriter::ColumnType> types;
+        RecordSchema<Record>::Visit(Record(), [&](const char* name, const auto& value) {
+            names.emplace_back(name);
+            types.push_back(ColumnarTypeOf<std::decay_t<decltype(value)>>());
+        });
+        names.emplace_back("SEED");
+        types.push_back(ColumnarTableWriter::INT64);
+        names.emplace_back("RUN");
+        types.push_back(ColumnarTableWriter::INT64);
+        m_writer.Open(filename, names, types, rowGroupSize);
+    }
+
+    /// \param record row to be written
+    void Save(const Record& record) override
+    {
+        RecordSchema<Record>::Visit(record, [this](const char*, const auto& value) {
+            using T = std::decay_t<decltype(value)>;
+            if constexpr (std::is_floating_point<T>::value)
+            {
+                m_writer.Append(static_cast<double>(value));
+            }
+            else if constexpr (std::is_arithmetic<T>::value)
+            {
+                m_writer.Append(static_cast<int64_t>(value));
+            }
+            else
+            {
+                m_writer.Append(value);
+            }
+        });
+        m_writer.Append(static_cast<int64_t>(SlOutputSeedRun::Get().seed));
+        m_writer.Append(static_cast<int64_t>(SlOutputSeedRun::Get().run));
+        m_writer.EndRow();
+    }
+
+    /// Write the rows of the current row group.
+    void EmptyCache() override
+    {
+        m_writer.Flush();
+    }
+
+  private:
+    ColumnarTableWriter m_writer; //!< the table file
+};
+
+} // namespace ns3
+
+#endif /* COLUMNAR_SL_OUTPUT_STATS_H */
@@ -0,0 +1,202 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "columnar-table-writer.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace ns3
+{
+
+static const char COLUMNAR_MAGIC[8] = {'S', 'L', 'C', 'O', 'L', '1', '\0', '\0'};
+
+static void
+PutU32(std::string& out, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+static void
+PutVarint(std::string& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static uint64_t
+ZigZag(int64_t value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+ColumnarTableWriter::~ColumnarTableWriter()
+{
+    if (m_file.is_open())
+    {
+        Flush();
+    }
+}
+
+void
+ColumnarTableWriter::Open(const std::string& filename,
+                          const std::vector<std::string>& names,
+                          const std::vector<ColumnType>& types,
+                          uint32_t rowGroupSize)
+{
+    NS_ABORT_MSG_UNLESS(names.size() == types.size(), "One type per column");
+    m_file.open(filename, std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Could not create " << filename);
+    m_rowGroupSize = std::max<uint32_t>(rowGroupSize, 1);
+
+    std::string schema(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+    PutU32(schema, names.size());
+    m_columns.clear();
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        schema.push_back(static_cast<char>(types[i]));
+        PutVarint(schema, names[i].size());
+        schema += names[i];
+        m_columns.push_back(Column{types[i], {}, {}, {}});
+    }
+    m_file.write(schema.data(), schema.size());
+    m_bytes = schema.size();
+}
+
+void
+ColumnarTableWriter::Append(int64_t value)
+{
+    NS_ABORT_MSG_UNLESS(m_next < m_columns.size() && m_columns[m_next].type == INT64,
+                        "Column " << m_next << " is not INT64");
+    m_columns[m_next++].ints.push_back(value);
+}
+
+void
+ColumnarTableWriter::Append(double value)
+{
+    NS_ABORT_MSG_UNLESS(m_next < m_columns.size() && m_columns[m_next].type == DOUBLE,
+                        "Column " << m_next << " is not DOUBLE");
+    m_columns[m_next++].doubles.push_back(value);
+}
+
+void
+ColumnarTableWriter::Append(const std::string& value)
+{
+    NS_ABORT_MSG_UNLESS(m_next < m_columns.size() && m_columns[m_next].type == STRING,
+                        "Column " << m_next << " is not STRING");
+    m_columns[m_next++].strings.push_back(value);
+}
+
+void
+ColumnarTableWriter::EndRow()
+{
+    NS_ABORT_MSG_UNLESS(m_next == m_columns.size(),
+                        "Row with " << m_next << " of " << m_columns.size() << " columns");
+    m_next = 0;
+    if (++m_rows >= m_rowGroupSize)
+    {
+        WriteRowGroup();
+    }
+}
+
+void
+ColumnarTableWriter::Flush()
+{
+    WriteRowGroup();
+    m_file.flush();
+}
+
+uint64_t
+ColumnarTableWriter::GetBytesWritten() const
+{
+    return m_bytes;
+}
+
+void
+ColumnarTableWriter::Encode(const Column& column, std::string& out)
+{
+    switch (column.type)
+    {
+    case INT64: {
+        int64_t previous = 0;
+        for (int64_t value : column.ints)
+        {
+            PutVarint(out, ZigZag(static_cast<int64_t>(static_cast<uint64_t>(value) -
+                                                       static_cast<uint64_t>(previous))));
+            previous = value;
+        }
+        break;
+    }
+    case DOUBLE: {
+        uint64_t previous = 0;
+        for (double value : column.doubles)
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            PutVarint(out, bits ^ previous);
+            previous = bits;
+        }
+        break;
+    }
+    case STRING: {
+        std::unordered_map<std::string, uint32_t> ids;
+        std::vector<const std::string*> dictionary;
+        std::string indexes;
+        for (const auto& value : column.strings)
+        {
+            auto it = ids.emplace(value, dictionary.size()).first;
+            if (it->second == dictionary.size())
+            {
+                dictionary.push_back(&it->first);
+            }
+            PutVarint(indexes, it->second);
+        }
+        PutVarint(out, dictionary.size());
+        for (const std::string* entry : dictionary)
+        {
+            PutVarint(out, entry->size());
+            out += *entry;
+        }
+        out += indexes;
+        break;
+    }
+    }
+}
+
+void
+ColumnarTableWriter::WriteRowGroup()
+{
+    if (m_rows == 0)
+    {
+        return;
+    }
+    std::string group;
+    PutU32(group, m_rows);
+    for (auto& column : m_columns)
+    {
+        m_chunk.clear();
+        Encode(column, m_chunk);
+        group.push_back(static_cast<char>(column.type));
+        PutU32(group, m_chunk.size());
+        group += m_chunk;
+        column.ints.clear();
+        column.doubles.clear();
+        column.strings.clear();
+    }
+    m_file.write(group.data(), group.size());
+    NS_ABORT_MSG_UNLESS(m_file.good(), "Could not write a row group");
+    m_bytes += group.size();
+    m_rows = 0;
+}
+
+} // namespace ns3
@@ -0,0 +1,109 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef COLUMNAR_TABLE_WRITER_H
+#define COLUMNAR_TABLE_WRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Append-only, column-oriented table file.
+ *
+ * Rows are buffered column by column and written in row groups. Inside a row
+ * group every column is a separate chunk, prefixed by its size, so a reader
+ * seeks over the columns it does not need. Each column type has its own
+ * encoding:
+ *
+ * - INT64: zigzag of the difference with the previous value, as a LEB128
+ *   varint. Counters, frame/slot numbers and ids take one or two bytes.
+ * - DOUBLE: bits XORed with the previous value, as a varint. Slowly
+ *   changing values (timestamps, SINR) share their high bits and shrink.
+ * - STRING: dictionary of the distinct values of the row group, then one
+ *   varint index per row.
+ *
+ * File layout, little endian:
+ * \verbatim
+   "SLCOL1\0\0"  u32 columnCount  { u8 type, varint nameLength, name }
+   row group:    u32 rowCount     { u8 type, u32 chunkBytes, chunk }
+   \endverbatim
+ * A file cut by a crash is still readable up to its last complete row
+ * group. sweep/sl_columnar.py reads the files.
+ */
+class ColumnarTableWriter
+{
+  public:
+    /// Type, and encoding, of a column.
+    enum ColumnType : uint8_t
+    {
+        INT64 = 1,
+        DOUBLE = 2,
+        STRING = 3,
+    };
+
+    ColumnarTableWriter() = default;
+    ~ColumnarTableWriter();
+
+    ColumnarTableWriter(const ColumnarTableWriter&) = delete;
+    ColumnarTableWriter& operator=(const ColumnarTableWriter&) = delete;
+
+    /**
+     * Create, or truncate, \p filename and write the schema.
+     * \param filename the file
+     * \param names column names
+     * \param types column types
+     * \param rowGroupSize rows per row group
+     */
+    void Open(const std::string& filename,
+              const std::vector<std::string>& names,
+              const std::vector<ColumnType>& types,
+              uint32_t rowGroupSize);
+
+    /// \param value next value of the next column of the current row
+    void Append(int64_t value);
+    /// \param value next value of the next column of the current row
+    void Append(double value);
+    /// \param value next value of the next column of the current row
+    void Append(const std::string& value);
+
+    /// Terminate the current row; every column must have been appended.
+    void EndRow();
+
+    /// Write the buffered rows as a row group and flush the file.
+    void Flush();
+
+    /// \return bytes written so far
+    uint64_t GetBytesWritten() const;
+
+  private:
+    /// Buffered values of one column.
+    struct Column
+    {
+        ColumnType type;                  //!< type of the values
+        std::vector<int64_t> ints;        //!< INT64 values
+        std::vector<double> doubles;      //!< DOUBLE values
+        std::vector<std::string> strings; //!< STRING values
+    };
+
+    /// Encode \p column into \p out.
+    static void Encode(const Column& column, std::string& out);
+    /// Write the buffered rows.
+    void WriteRowGroup();
+
+    std::ofstream m_file;          //!< output
+    std::vector<Column> m_columns; //!< current row group
+    uint32_t m_next{0};            //!< next column of the current row
+    uint32_t m_rows{0};            //!< complete rows in m_columns
+    uint32_t m_rowGroupSize{1};    //!< rows per row group
+    uint64_t m_bytes{0};           //!< bytes written
+    std::string m_chunk;           //!< scratch buffer of Encode
+};
+
+} // namespace ns3
+
+#endif /* COLUMNAR_TABLE_WRITER_H */
@@ -1,35 +1,373 @@
+#include "ns2-binary-mobility-helper.h"
+#include "ns2-streaming-mobility-helper.h"
+#include "sim-profiler.h"
+#include "sl-activity-monitor.h"
+#include "sl-branch-point.h"
+#include "sl-channel-cache.h"
+#include "sl-heap-hooks.h"
+#include "sl-kpi-engine.h"
+#include "sl-output-backend.h"
+#include "sl-pooled-cbr-client.h"
+#include "sl-proximity-spectrum-channel.h"
+#include "sl-region-monitor.h"
+#include "sl-sensing-store.h"
+#include "sl-spectrum-arena.h"
+#include "sl-trace-wiring.h"
+#include "sl-v2x-workload.h"
+#include "sl-vector-eesm-error-model.h"
+#include "slot-wheel-scheduler.h"
 #include "ns3/rng-seed-manager.h"
 #include "ns3/mobility-helper.h"
 #include "ns3/ns2-mobility-helper.h"
+#include "ns3/command-line.h"
 #include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/uinteger.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/string.h"
 #include "ns3/nr-point-to-point-epc-helper.h"
 #include "ns3/ideal-beamforming-helper.h"
 #include "ns3/nr-helper.h"
 #include <ns3/cc-bwp-helper.h>
 #include <ns3/pointer.h>
 #include <ns3/isotropic-antenna-model.h> 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 #include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+
+/*
+ * Diagnostics of the experiment (packet metadata printing/checking and
+ * LOG_LEVEL_ALL of the EPC and BWP helpers). They are compiled in the ns-3
+ * debug profile and out of the release/optimized "production" profiles;
+ * build with -DEXP01_DIAGNOSTICS=0 or 1 to force either.
+ */
+#ifndef EXP01_DIAGNOSTICS
+#ifdef NS3_BUILD_PROFILE_DEBUG
+#define EXP01_DIAGNOSTICS 1
+#else
+#define EXP01_DIAGNOSTICS 0
+#endif
+#endif
 
 using namespace ns3;
 
+/*
+ * Application trace sink of the pktTxRx table, as in nr-v2x-simple-demo,
+ * saved into the backend selected by --outputFormat (sl-output-backend.h).
+ * The MAC/PHY tables are wired by SlTraceWiring (sl-trace-wiring.h).
+ */
+void
+UePacketTraceDb(SlRecordSink<PktTxRxRecord>* stats,
+                Ptr<Node> node,
+                const Address& localAddrs,
+                std::string txRx,
+                Ptr<const Packet> p,
+                const Address& srcAddrs,
+                const Address& dstAddrs,
+                const SeqTsSizeHeader& seqTsSizeHeader)
+{
+    uint32_t nodeId = node->GetId();
+    uint64_t imsi = node->GetDevice(0)->GetObject<NrUeNetDevice>()->GetImsi();
+    uint32_t seq = seqTsSizeHeader.GetSeq();
+    uint32_t pktSize = p->GetSize() + seqTsSizeHeader.GetSerializedSize();
+    stats->Save(MakePktTxRxRecord(txRx, nodeId, imsi, pktSize, srcAddrs, dstAddrs, seq));
+}
+
+/*
+ * Application traces of the KPI engine (sl-kpi-engine.h), which replaces the
+ * txByteCounter/rxByteCounter/pir counters of nr-v2x-simple-demo.
+ */
+void
+KpiTxTrace(SlKpiEngine* kpi,
+           Ptr<Node> node,
+           Ptr<const Packet> p,
+           const Address& srcAddrs,
+           const Address& dstAddrs,
+           const SeqTsSizeHeader& seqTsSizeHeader)
+{
+    kpi->NotifyTx(node, p->GetSize() + seqTsSizeHeader.GetSerializedSize());
+}
+
+void
+KpiRxTrace(SlKpiEngine* kpi,
+           Ptr<Node> node,
+           Ptr<const Packet> p,
+           const Address& srcAddrs,
+           const Address& dstAddrs,
+           const SeqTsSizeHeader& seqTsSizeHeader)
+{
+    kpi->NotifyRx(node,
+                  srcAddrs,
+                  p->GetSize() + seqTsSizeHeader.GetSerializedSize(),
+                  seqTsSizeHeader.GetTs());
+}
+
 int main (int argc, char *argv[]) {
     static const uint8_t gNB_total = 2;
+    std::string mobilityTrace = "mob01.tcl";
+    double mobilityWindow = 0;
+    // Trace positions computed when asked for instead of by events
+    bool lazyMobility = false;
+    // Parameters swept by sweep/exp01_sweep.py
+    uint32_t seed = 1;
+    uint64_t run = 1;
+    uint32_t ueCount = 50;
+    uint16_t numerologyBwp1 = 4;
+    uint16_t initialNrSlMcs = 14;
+    double dataRateBe = 16; // 16 kilobits per second
+    // Where we will store the output files.
+    std::string simTag = "default";
+    std::string outputDir = "./";
+    // Format of the sidelink stats, rows per SQLite transaction or columnar
+    // row group, and whether a thread writes the SQLite batches
+    std::string outputFormat = "sqlite";
+    uint32_t dbBatchSize = 100000;
+    bool dbBackgroundWriter = false;
+    // KPI engine bins, and whether the per-packet pktTxRx rows are written
+    double kpiTimeBin = 1.0;
+    double kpiDistanceBin = 25.0;
+    uint32_t kpiDistanceBins = 20;
+    bool pktTxRxRows = true;
+    // MAC/PHY records buffered per node before they reach the stats
+    uint32_t slTraceBuffer = 64;
+    // Sensing-based selection done by the scheduler on bitsets
+    bool slSensing = false;
+    // Sidelink slots every UE sends or receives a PSSCH in
+    bool slActivityReport = false;
+    // Effective SINR mapping of the sidelink error model
+    std::string slEesmKernel = "stock";
+    bool slEesmVerify = false;
+    // Relative geometry cell inside which channel matrices are reused
+    double channelCacheCell = 0;
+    // Sidelink interference range; 0 delivers every signal to every UE
+    double slInterferenceRange = 0;
+    // Per-receiver signal copies recycled through free lists
+    bool spectrumArena = false;
+    // Load balance and coupling of a partition of the UEs by gNB region
+    bool regionReport = false;
+    double regionSample = 1.0;
+    // Variants forked from a shared warm-up
+    double branchAt = 0;
+    std::string branchFile;
+    uint32_t branchJobs = 0;
+    // Groupcast client sending recycled packets
+    bool packetPool = false;
+    // All-to-all CAM and event traffic instead of one OnOff sender
+    bool v2xWorkload = false;
+    uint32_t v2xCamSize = 190;
+    double v2xCamPeriodMin = 0.1;
+    double v2xCamPeriodMax = 0.1;
+    double v2xCamJitter = 0.0;
+    bool v2xCamDynamic = false;
+    double v2xEventRate = 0.1;
+    uint32_t v2xEventSize = 300;
+    uint32_t v2xEventRepetitions = 1;
+    // Event queue of the simulator
+    std::string scheduler = "map";
+    // Event counts and wall clock of Simulator::Run, per event type
+    bool profile = false;
+    double profileBin = 10.0;
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("seed", "RngSeedManager seed", seed);
+    cmd.AddValue("run", "RngSeedManager run number", run);
+    cmd.AddValue("ueCount", "Number of UEs driven by the mobility trace", ueCount);
+    cmd.AddValue("numerology", "Numerology of the bandwidth part of band1", numerologyBwp1);
+    cmd.AddValue("mcs", "Fixed MCS of the sidelink scheduler (InitialNrSlMcs)", initialNrSlMcs);
+    cmd.AddValue("dataRateBe",
+                 "The data rate in kilobits per second for best effort traffic",
+                 dataRateBe);
+    cmd.AddValue("simTag",
+                 "tag to be appended to output filenames to distinguish simulation campaigns",
+                 simTag);
+    cmd.AddValue("outputDir", "directory where to store simulation results", outputDir);
+    cmd.AddValue("outputFormat",
+                 "Format of the sidelink stats: sqlite (<simTag>-nr-v2x-simple-demo.db) "
+                 "or columnar (one <simTag>-nr-v2x-simple-demo-<table>.slc per table)",
+                 outputFormat);
+    cmd.AddValue("dbBatchSize",
+                 "Rows of a stats table written at once (SQLite transaction or "
+                 "columnar row group); bounds the memory used by the stats",
+                 dbBatchSize);
+    cmd.AddValue("dbBackgroundWriter",
+                 "Write the stats batches from a background thread",
+                 dbBackgroundWriter);
+    cmd.AddValue("kpiTimeBin", "Width, in seconds, of the time bins of the KPIs", kpiTimeBin);
+    cmd.AddValue("kpiDistanceBin",
+                 "Width, in meters, of the distance bins of the PDR",
+                 kpiDistanceBin);
+    cmd.AddValue("kpiDistanceBins",
+                 "Number of distance bins of the PDR, the last one is open",
+                 kpiDistanceBins);
+    cmd.AddValue("slTraceBuffer",
+                 "MAC/PHY trace records buffered per node before they reach the stats",
+                 slTraceBuffer);
+    cmd.AddValue("slSensing",
+                 "Exclude the resources reserved by the sensed PSCCHs with "
+                 "SlSensingScheduler, keeping the MAC sensing (EnableSensing) off",
+                 slSensing);
+    cmd.AddValue("slActivityReport",
+                 "Count the slots every UE sends or receives a PSSCH in, and write them to "
+                 "<simTag>-nr-v2x-simple-demo-sl-activity.csv",
+                 slActivityReport);
+    cmd.AddValue("pktTxRxRows",
+                 "Write one pktTxRx row per packet; the KPI summaries are always written",
+                 pktTxRxRows);
+    cmd.AddValue("mobilityTrace",
+                 "ns-2 trace inside mobility/, .tcl or binary .ns2b (see ns2-tcltool)",
+                 mobilityTrace);
+    cmd.AddValue("mobilityWindow",
+                 "If > 0, stream the trace scheduling only the next mobilityWindow "
+                 "seconds of waypoints; 0 schedules the whole trace at start-up",
+                 mobilityWindow);
+    cmd.AddValue("lazyMobility",
+                 "Record the trace courses in Ns2LazyMobilityModel, which computes a "
+                 "position only when it is asked for, instead of scheduling one event "
+                 "per waypoint; a .tcl trace is then streamed",
+                 lazyMobility);
+    cmd.AddValue("slEesmKernel",
+                 "Effective SINR mapping of the sidelink error model: stock (NrEesmIrT1), "
+                 "or SlVectorEesmIrT1 with the auto, scalar, avx2 or avx512 kernel",
+                 slEesmKernel);
+    cmd.AddValue("slEesmVerify",
+                 "Compare every kernel mapping with NrEesmIrT1 and report the mismatches",
+                 slEesmVerify);
+    cmd.AddValue("channelCacheCell",
+                 "If > 0, the 3GPP channel matrix and condition of a UE pair are "
+                 "regenerated only when their relative position leaves a cell of this "
+                 "edge, in meters; 0 keeps UpdatePeriod = 0 (generated once per pair)",
+                 channelCacheCell);
+    cmd.AddValue("slInterferenceRange",
+                 "If > 0, the channel only delivers a sidelink signal to the UEs within "
+                 "this many meters of the transmitter; 0 keeps the stock channel",
+                 slInterferenceRange);
+    cmd.AddValue("spectrumArena",
+                 "Recycle the per-receiver copies of a signal and its PSD made by the "
+                 "proximity channel (needs slInterferenceRange > 0) through free lists "
+                 "instead of the heap (SlSpectrumArena); the rest of the reception, "
+                 "SINR included, still allocates from the heap",
+                 spectrumArena);
+    cmd.AddValue("regionReport",
+                 "Write the UEs per gNB region over time and the intra/cross-region "
+                 "signals (needs slInterferenceRange > 0) to "
+                 "<simTag>-nr-v2x-simple-demo-regions-*.csv",
+                 regionReport);
+    cmd.AddValue("regionSample",
+                 "Time, in seconds, between two assignments of the UEs to the regions",
+                 regionSample);
+    cmd.AddValue("branchAt",
+                 "If > 0, fork at this time, in seconds, before the end of the "
+                 "simulation, one process per line of branchFile; each applies its Config "
+                 "settings and writes its outputs and run statistics with "
+                 "<simTag>-<branch tag>",
+                 branchAt);
+    cmd.AddValue("branchFile",
+                 "Branches: one per line, a tag followed by path=value Config settings",
+                 branchFile);
+    cmd.AddValue("branchJobs", "Branches running at a time, 0 for one per CPU", branchJobs);
+    cmd.AddValue("packetPool",
+                 "Send the groupcast traffic with SlPooledCbrClient, which recycles its "
+                 "packets, instead of OnOff; the heap allocations per packet are counted "
+                 "when the allocator hooks are built in (SL_HEAP_HOOKS)",
+                 packetPool);
+    cmd.AddValue("v2xWorkload",
+                 "Every UE sends CAMs and event messages to all the others (ports port "
+                 "and port + 1) instead of one OnOff sender and one sink; per-flow "
+                 "counters go to <simTag>-nr-v2x-simple-demo-v2x-flows.csv",
+                 v2xWorkload);
+    cmd.AddValue("v2xCamSize", "CAM size in bytes", v2xCamSize);
+    cmd.AddValue("v2xCamPeriodMin",
+                 "Shortest CAM period, in seconds; the period of every UE is drawn "
+                 "uniformly between v2xCamPeriodMin and v2xCamPeriodMax",
+                 v2xCamPeriodMin);
+    cmd.AddValue("v2xCamPeriodMax", "Longest CAM period, in seconds", v2xCamPeriodMax);
+    cmd.AddValue("v2xCamJitter",
+                 "Every CAM interval is drawn in the period +/- this many seconds",
+                 v2xCamJitter);
+    cmd.AddValue("v2xCamDynamic",
+                 "Generate the CAMs on the ETSI heading/position/speed conditions, "
+                 "checked every CAM period, and at least once per second",
+                 v2xCamDynamic);
+    cmd.AddValue("v2xEventRate", "Event-triggered messages per UE per second", v2xEventRate);
+    cmd.AddValue("v2xEventSize", "Event message size in bytes", v2xEventSize);
+    cmd.AddValue("v2xEventRepetitions", "Messages sent per event", v2xEventRepetitions);
+    cmd.AddValue("scheduler",
+                 "Event queue of the simulator: map (ns-3 default), heap, list, calendar, "
+                 "or wheel (SlotWheelScheduler, buckets of one slot of the numerology)",
+                 scheduler);
+    cmd.AddValue("profile",
+                 "Count and time the events of Simulator::Run by type; the report is "
+                 "written to <outputDir><simTag>-profile.txt",
+                 profile);
+    cmd.AddValue("profileBin",
+                 "Width, in simulated seconds, of the time bins of the profile",
+                 profileBin);
+    cmd.Parse(argc, argv);
+    const std::map<std::string, std::string> schedulerTypes = {
+        {"map", "ns3::MapScheduler"},
+        {"heap", "ns3::HeapScheduler"},
+        {"list", "ns3::ListScheduler"},
+        {"calendar", "ns3::CalendarScheduler"},
+        {"wheel", "ns3::SlotWheelScheduler"},
+    };
+    NS_ABORT_MSG_UNLESS(schedulerTypes.count(scheduler), "Unknown scheduler " << scheduler);
+    NS_ABORT_MSG_IF(spectrumArena && slInterferenceRange <= 0,
+                    "spectrumArena needs slInterferenceRange > 0");
+    NS_ABORT_MSG_IF(regionReport && slInterferenceRange <= 0,
+                    "regionReport needs slInterferenceRange > 0");
+    Config::SetDefault("ns3::SlotWheelScheduler::SlotDuration",
+                       TimeValue(NanoSeconds(1000000 >> numerologyBwp1)));
+    GlobalValue::Bind("SchedulerType",
+                      TypeIdValue(TypeId::LookupByName(schedulerTypes.at(scheduler))));
+    if (profile)
+    {
+        // Before anything is scheduled, so that every event is seen
+        SimProfiler::Install(Seconds(profileBin));
+    }
     // 1. Randomize
     // LogComponentEnable("RngSeedManager", LOG_LEVEL_ALL);
-	RngSeedManager::SetSeed (1);
-	RngSeedManager::SetRun (1);
+	RngSeedManager::SetSeed (seed);
+	RngSeedManager::SetRun (run);
     // 2. Create nodes to attach UEs
     NodeContainer ues;
-    ues.Create(50);
+    ues.Create(ueCount);
     // 3. Load mobility from tcl file
     // LogComponentEnable("Ns2MobilityHelper", LOG_LEVEL_ALL);
     std::filesystem::path home_path = "./scratch/one_v2x";
     std::filesystem::path mobi_path = home_path / "mobility";
-	Ns2MobilityHelper ns2 = Ns2MobilityHelper (mobi_path / "mob01.tcl");
-	ns2.Install (ues.Begin(), ues.End());
+    std::filesystem::path mobility_trace = mobi_path / mobilityTrace;
+    // Streaming keeps only mobilityWindow seconds of waypoints in the event
+    // queue; binary traces (mobility/ns2-tcltool convert) are mmap'd instead
+    // of parsed. Lazy courses fire CourseChange only when the proximity
+    // grid of slInterferenceRange listens to it
+    Config::SetDefault("ns3::Ns2LazyMobilityModel::NotifyCourseChanges",
+                       BooleanValue(slInterferenceRange > 0));
+    bool binaryTrace = mobility_trace.extension() == ".ns2b";
+    if (mobilityWindow > 0 || (lazyMobility && !binaryTrace))
+    {
+        Ns2StreamingMobilityHelper ns2 = Ns2StreamingMobilityHelper (mobility_trace);
+        if (mobilityWindow > 0)
+        {
+            ns2.SetWindow (Seconds (mobilityWindow));
+        }
+        ns2.SetLazy (lazyMobility);
+        ns2.Install (ues.Begin(), ues.End());
+    }
+    else if (binaryTrace)
+    {
+        Ns2BinaryMobilityHelper ns2 = Ns2BinaryMobilityHelper (mobility_trace);
+        ns2.SetLazy (lazyMobility);
+        ns2.Install (ues.Begin(), ues.End());
+    }
+    else
+    {
+        Ns2MobilityHelper ns2 = Ns2MobilityHelper (mobility_trace);
+        ns2.Install (ues.Begin(), ues.End());
+    }
     // 4. Create gNBs
     NodeContainer gnbs;
     gnbs.Create(gNB_total);
@@ -114,7 +452,9 @@ int main (int argc, char *argv[]) {
     * All links will be point-to-point, with some properties.
     * The user can set the point-to-point links properties by using:
     */
+#if EXP01_DIAGNOSTICS
     LogComponentEnable("NrPointToPointEpcHelper", LOG_LEVEL_ALL);
+#endif
     Ptr<NrPointToPointEpcHelper> epcHelper = CreateObject<NrPointToPointEpcHelper>();
     /**
     *  
@@ -365,7 +705,8 @@ int main (int argc, char *argv[]) {
     * para diversas aplicações.
     * 
     */
-    uint16_t numerologyBwp1 = 4;
+    // the sidelink BWP uses the numerology chosen with --numerology
+    uint16_t numerologyBwpSl = numerologyBwp1;
     double centralFrequencyBand1 = 28e9;
     double bandwidthBand1 = 1e8;
     double totalTxPower = 4;
@@ -387,7 +728,9 @@ int main (int argc, char *argv[]) {
      * component carriers (CC) and their contiguousness
      */                                                    
     // By using the configuration created, it is time to make the operation bands
+#if EXP01_DIAGNOSTICS
     LogComponentEnable("CcBwpHelper", LOG_LEVEL_ALL);
+#endif
     OperationBandInfo band1 = ccBwpCreator.CreateOperationBandContiguousCc(bandConf1);
     /*
     * Período de atualização de canal no contexto de 5G NR
@@ -502,6 +845,67 @@ int main (int argc, char *argv[]) {
      * will take care of all the spectrum initialization needs.
      */
     nrHelper->InitializeOperationBand(&band1);
+    Ptr<SlCachedChannelModel> cachedChannel;
+    Ptr<SlCachedChannelConditionModel> cachedCondition;
+    if (channelCacheCell > 0)
+    {
+        // The stock models regenerate whenever asked; the caches decide when
+        auto& bwp = band1.GetBwpAt(0, 0);
+        bwp->m_propagationCondition->SetAttribute("UpdatePeriod", TimeValue(NanoSeconds(1)));
+        cachedCondition = CreateObject<SlCachedChannelConditionModel>();
+        cachedCondition->SetAttribute("Inner", PointerValue(bwp->m_propagationCondition));
+        cachedCondition->SetAttribute("CellSize", DoubleValue(channelCacheCell));
+        bwp->m_propagation->SetAttribute("ChannelConditionModel", PointerValue(cachedCondition));
+        bwp->m_propagationCondition = cachedCondition;
+
+        PointerValue stock;
+        bwp->m_3gppChannel->GetAttribute("ChannelModel", stock);
+        DoubleValue frequency;
+        StringValue scenario;
+        stock.Get<ThreeGppChannelModel>()->GetAttribute("Frequency", frequency);
+        stock.Get<ThreeGppChannelModel>()->GetAttribute("Scenario", scenario);
+        cachedChannel = CreateObject<SlCachedChannelModel>();
+        cachedChannel->SetAttribute("Frequency", frequency);
+        cachedChannel->SetAttribute("Scenario", scenario);
+        cachedChannel->SetAttribute("ChannelConditionModel", PointerValue(cachedCondition));
+        cachedChannel->SetAttribute("UpdatePeriod", TimeValue(NanoSeconds(1)));
+        cachedChannel->SetAttribute("CellSize", DoubleValue(channelCacheCell));
+        bwp->m_3gppChannel->SetAttribute("ChannelModel", PointerValue(cachedChannel));
+    }
+    Ptr<SlProximitySpectrumChannel> proximityChannel;
+    if (slInterferenceRange > 0)
+    {
+        // Same loss models as the stock channel, but the receivers beyond
+        // the range are skipped instead of computed and discarded
+        Ptr<SpectrumChannel> stock = band1.GetBwpAt(0, 0)->m_channel;
+        proximityChannel = CreateObject<SlProximitySpectrumChannel>();
+        proximityChannel->SetAttribute("Range", DoubleValue(slInterferenceRange));
+        if (spectrumArena)
+        {
+            NS_ABORT_MSG_UNLESS(SlHeapCounter::IsEnabled(),
+                                "spectrumArena needs the allocator hooks; build with "
+                                "-DSL_HEAP_HOOKS=1");
+            SlSpectrumArena::Enable();
+        }
+        DoubleValue maxLossDb;
+        stock->GetAttribute("MaxLossDb", maxLossDb);
+        proximityChannel->SetAttribute("MaxLossDb", maxLossDb);
+        if (stock->GetPropagationLossModel())
+        {
+            proximityChannel->AddPropagationLossModel(stock->GetPropagationLossModel());
+        }
+        if (stock->GetSpectrumPropagationLossModel())
+        {
+            proximityChannel->AddSpectrumPropagationLossModel(
+                stock->GetSpectrumPropagationLossModel());
+        }
+        if (stock->GetPhasedArraySpectrumPropagationLossModel())
+        {
+            proximityChannel->AddPhasedArraySpectrumPropagationLossModel(
+                stock->GetPhasedArraySpectrumPropagationLossModel());
+        }
+        band1.GetBwpAt(0, 0)->m_channel = proximityChannel;
+    }
     /*
      * Start to account for the bandwidth used by the example, as well as
      * the total power that has to be divided among the BWPs.
@@ -583,8 +987,10 @@ int main (int argc, char *argv[]) {
      * The performance aspects copy-on-write semantics of the
      * Packet API are discussed in \ref packetperf
      */
+#if EXP01_DIAGNOSTICS
     Packet::EnableChecking();
-    Packet::EnablePrinting();    
+    Packet::EnablePrinting();
+#endif
    /*
      *  Case (i): Attributes valid for all the nodes
      */
@@ -760,6 +1166,8 @@ int main (int argc, char *argv[]) {
      * We have configured the attributes we needed. Now, install and get the pointers
      * to the NetDevices, which contains all the NR stack:
      */
+    // UEs given the sidelink stack
+    NodeContainer ueVoiceContainer = ues;
     NetDeviceContainer ueVoiceNetDev = nrHelper->InstallUeDevice(ueVoiceContainer, allBwps);
 
     /*
@@ -794,6 +1202,12 @@ int main (int argc, char *argv[]) {
      * AMC type: NrAmc::ShannonModel or NrAmc::ErrorModel
      */
     std::string errorModel = "ns3::NrEesmIrT1";
+    if (slEesmKernel != "stock")
+    {
+        errorModel = "ns3::SlVectorEesmIrT1";
+        Config::SetDefault("ns3::SlVectorEesmIrT1::Kernel", StringValue(slEesmKernel));
+        Config::SetDefault("ns3::SlVectorEesmIrT1::Verify", BooleanValue(slEesmVerify));
+    }
     nrSlHelper->SetSlErrorModel(errorModel);
     nrSlHelper->SetUeSlAmcAttribute("AmcModel", EnumValue(NrAmc::ErrorModel));
 
@@ -802,9 +1216,12 @@ int main (int argc, char *argv[]) {
      * In this example we use NrSlUeMacSchedulerSimple scheduler, which uses
      * fix MCS value
      */
-    nrSlHelper->SetNrSlSchedulerTypeId(NrSlUeMacSchedulerSimple::GetTypeId());
+    // SlSensingScheduler is NrSlUeMacSchedulerSimple with the candidates
+    // reserved by the sensed PSCCHs excluded
+    nrSlHelper->SetNrSlSchedulerTypeId(slSensing ? SlSensingScheduler::GetTypeId()
+                                                 : NrSlUeMacSchedulerSimple::GetTypeId());
     nrSlHelper->SetUeSlSchedulerAttribute("FixNrSlMcs", BooleanValue(true));
-    nrSlHelper->SetUeSlSchedulerAttribute("InitialNrSlMcs", UintegerValue(14));
+    nrSlHelper->SetUeSlSchedulerAttribute("InitialNrSlMcs", UintegerValue(initialNrSlMcs));
 
     /*
      * Very important method to configure UE protocol stack, i.e., it would
@@ -813,6 +1230,10 @@ int main (int argc, char *argv[]) {
      * API.
      */
     nrSlHelper->PrepareUeForSidelink(ueVoiceNetDev, bwpIdContainer);
+    if (slSensing)
+    {
+        SlSensingScheduler::Connect(ueVoiceNetDev);
+    }
 
     /*
      * Start preparing for all the sub Structs/RRC Information Element (IEs)
@@ -1009,7 +1430,48 @@ int main (int argc, char *argv[]) {
     std::cout << "Data rate " << DataRate(dataRateBeString) << std::endl;
     sidelinkClient.SetConstantRate(DataRate(dataRateBeString), udpPacketSizeBe);
 
-    ApplicationContainer clientApps = sidelinkClient.Install(ueVoiceContainer.Get(0));
+    ApplicationContainer clientApps;
+    Ptr<SlPooledCbrClient> pooledClient;
+    SlV2xWorkload workload;
+    if (v2xWorkload)
+    {
+        workload.SetAttribute("CamSize", UintegerValue(v2xCamSize));
+        workload.SetAttribute("CamJitter", TimeValue(Seconds(v2xCamJitter)));
+        workload.SetAttribute("CamDynamic", BooleanValue(v2xCamDynamic));
+        workload.SetAttribute("EventRate", DoubleValue(v2xEventRate));
+        workload.SetAttribute("EventSize", UintegerValue(v2xEventSize));
+        workload.SetAttribute("EventRepetitions", UintegerValue(v2xEventRepetitions));
+        workload.SetCamPeriodRange(Seconds(v2xCamPeriodMin), Seconds(v2xCamPeriodMax));
+        Address eventAddress;
+        if (!useIPv6)
+        {
+            eventAddress = InetSocketAddress(groupAddress4, port + 1);
+        }
+        else
+        {
+            eventAddress = Inet6SocketAddress(groupAddress6, port + 1);
+            for (uint32_t u = 0; u < ueVoiceContainer.GetN(); ++u)
+            {
+                ueVoiceContainer.Get(u)->GetObject<Ipv6L3Protocol>()->AddMulticastAddress(
+                    groupAddress6);
+            }
+        }
+        stream += workload.Install(ueVoiceContainer, remoteAddress, eventAddress, stream);
+        clientApps = workload.GetClients();
+    }
+    else if (packetPool)
+    {
+        pooledClient = CreateObject<SlPooledCbrClient>();
+        pooledClient->SetAttribute("Remote", AddressValue(remoteAddress));
+        pooledClient->SetAttribute("PacketSize", UintegerValue(udpPacketSizeBe));
+        pooledClient->SetAttribute("DataRate", DataRateValue(DataRate(dataRateBeString)));
+        ueVoiceContainer.Get(0)->AddApplication(pooledClient);
+        clientApps.Add(pooledClient);
+    }
+    else
+    {
+        clientApps = sidelinkClient.Install(ueVoiceContainer.Get(0));
+    }
     // onoff application will send the first packet at :
     // finalSlBearersActivationTime + ((Pkt size in bits) / (Data rate in bits per sec))
     clientApps.Start(finalSlBearersActivationTime);
@@ -1027,7 +1489,14 @@ int main (int argc, char *argv[]) {
     ApplicationContainer serverApps;
     PacketSinkHelper sidelinkSink("ns3::UdpSocketFactory", localAddress);
     sidelinkSink.SetAttribute("EnableSeqTsSizeHeader", BooleanValue(true));
-    serverApps = sidelinkSink.Install(ueVoiceContainer.Get(ueVoiceContainer.GetN() - 1));
+    if (v2xWorkload)
+    {
+        serverApps = workload.GetSinks();
+    }
+    else
+    {
+        serverApps = sidelinkSink.Install(ueVoiceContainer.Get(ueVoiceContainer.GetN() - 1));
+    }
     serverApps.Start(Seconds(2.0));
 
     /*
@@ -1035,159 +1504,332 @@ int main (int argc, char *argv[]) {
      * stored in a database
      */
 
-    // Trace receptions; use the following to be robust to node ID changes
-    std::ostringstream path;
-    path << "/NodeList/" << ueVoiceContainer.Get(1)->GetId()
-         << "/ApplicationList/0/$ns3::PacketSink/Rx";
-    Config::ConnectWithoutContext(path.str(), MakeCallback(&ReceivePacket));
-    path.str("");
-
-    path << "/NodeList/" << ueVoiceContainer.Get(1)->GetId()
-         << "/ApplicationList/0/$ns3::PacketSink/Rx";
-    Config::ConnectWithoutContext(path.str(), MakeCallback(&ComputePir));
-    path.str("");
-
-    path << "/NodeList/" << ueVoiceContainer.Get(0)->GetId()
-         << "/ApplicationList/0/$ns3::OnOffApplication/Tx";
-    Config::ConnectWithoutContext(path.str(), MakeCallback(&TransmitPacket));
-    path.str("");
-
-    // Datebase setup
-    std::string exampleName = simTag + "-" + "nr-v2x-simple-demo";
-    SQLiteOutput db(outputDir + exampleName + ".db");
-
-    UeMacPscchTxOutputStats pscchStats;
-    pscchStats.SetDb(&db, "pscchTxUeMac");
-    Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/"
-                                  "ComponentCarrierMapUe/*/NrUeMac/SlPscchScheduling",
-                                  MakeBoundCallback(&NotifySlPscchScheduling, &pscchStats));
-
-    UeMacPsschTxOutputStats psschStats;
-    psschStats.SetDb(&db, "psschTxUeMac");
-    Config::ConnectWithoutContext("/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/"
-                                  "ComponentCarrierMapUe/*/NrUeMac/SlPsschScheduling",
-                                  MakeBoundCallback(&NotifySlPsschScheduling, &psschStats));
-
-    UePhyPscchRxOutputStats pscchPhyStats;
-    pscchPhyStats.SetDb(&db, "pscchRxUePhy");
-    Config::ConnectWithoutContext(
-        "/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/ComponentCarrierMapUe/*/NrUePhy/"
-        "NrSpectrumPhyList/*/RxPscchTraceUe",
-        MakeBoundCallback(&NotifySlPscchRx, &pscchPhyStats));
-
-    UePhyPsschRxOutputStats psschPhyStats;
-    psschPhyStats.SetDb(&db, "psschRxUePhy");
-    Config::ConnectWithoutContext(
-        "/NodeList/*/DeviceList/*/$ns3::NrUeNetDevice/ComponentCarrierMapUe/*/NrUePhy/"
-        "NrSpectrumPhyList/*/RxPsschTraceUe",
-        MakeBoundCallback(&NotifySlPsschRx, &psschPhyStats));
-
-    UeToUePktTxRxOutputStats pktStats;
-    pktStats.SetDb(&db, "pktTxRx");
-
-    if (!useIPv6)
+    // Throughput, PIR, latency and PDR versus distance, aggregated in memory
+    SlKpiEngine kpi(Seconds(kpiTimeBin), kpiDistanceBin, kpiDistanceBins);
+    for (uint32_t ac = 0; ac < clientApps.GetN(); ac++)
     {
-        // Set Tx traces
-        for (uint16_t ac = 0; ac < clientApps.GetN(); ac++)
+        Ptr<Node> node = clientApps.Get(ac)->GetNode();
+        if (!useIPv6)
         {
-            Ipv4Address localAddrs = clientApps.Get(ac)
-                                         ->GetNode()
-                                         ->GetObject<Ipv4L3Protocol>()
-                                         ->GetAddress(1, 0)
-                                         .GetLocal();
-            std::cout << "Tx address: " << localAddrs << std::endl;
-            clientApps.Get(ac)->TraceConnect("TxWithSeqTsSize",
-                                             "tx",
-                                             MakeBoundCallback(&UePacketTraceDb,
-                                                               &pktStats,
-                                                               ueVoiceContainer.Get(0),
-                                                               localAddrs));
+            kpi.AddTransmitter(node,
+                               node->GetObject<Ipv4L3Protocol>()->GetAddress(1, 0).GetLocal());
         }
-
-        // Set Rx traces
-        for (uint16_t ac = 0; ac < serverApps.GetN(); ac++)
+        else
         {
-            Ipv4Address localAddrs = serverApps.Get(ac)
-                                         ->GetNode()
-                                         ->GetObject<Ipv4L3Protocol>()
-                                         ->GetAddress(1, 0)
-                                         .GetLocal();
-            std::cout << "Rx address: " << localAddrs << std::endl;
-            serverApps.Get(ac)->TraceConnect("RxWithSeqTsSize",
-                                             "rx",
-                                             MakeBoundCallback(&UePacketTraceDb,
-                                                               &pktStats,
-                                                               ueVoiceContainer.Get(1),
-                                                               localAddrs));
+            kpi.AddTransmitter(node,
+                               node->GetObject<Ipv6L3Protocol>()->GetAddress(1, 1).GetAddress());
         }
+        clientApps.Get(ac)->TraceConnectWithoutContext("TxWithSeqTsSize",
+                                                       MakeBoundCallback(&KpiTxTrace, &kpi, node));
+    }
+    for (uint32_t ac = 0; ac < serverApps.GetN(); ac++)
+    {
+        Ptr<Node> node = serverApps.Get(ac)->GetNode();
+        kpi.AddReceiver(node);
+        serverApps.Get(ac)->TraceConnectWithoutContext("RxWithSeqTsSize",
+                                                       MakeBoundCallback(&KpiRxTrace, &kpi, node));
+    }
+
+    std::vector<Vector> regionCenters;
+    for (uint32_t i = 0; i < gnbs.GetN(); ++i)
+    {
+        regionCenters.push_back(gnbs.Get(i)->GetObject<MobilityModel>()->GetPosition());
+    }
+    SlRegionMonitor regions(regionCenters, Seconds(regionSample));
+    if (regionReport)
+    {
+        regions.Track(ues);
+        proximityChannel->TraceConnectWithoutContext(
+            "SignalDelivered",
+            MakeBoundCallback(&SlRegionMonitor::SignalDelivered, &regions));
+    }
+
+    // Datebase setup
+    std::string exampleName;
+    // Declared before the stats, so destroyed after them
+    std::unique_ptr<SlOutputBackend> output;
+    SlDeferredSink<SlPscchUeMacStatParameters> pscchStats;
+    SlDeferredSink<SlPsschUeMacStatParameters> psschStats;
+    SlDeferredSink<SlRxCtrlPacketTraceParams> pscchPhyStats;
+    SlDeferredSink<SlRxDataPacketTraceParams> psschPhyStats;
+    SlDeferredSink<PktTxRxRecord> pktStats;
+    auto openOutput = [&]() {
+        exampleName = simTag + "-" + "nr-v2x-simple-demo";
+        output = std::make_unique<SlOutputBackend>(SlOutputBackend::ParseFormat(outputFormat),
+                                                   outputDir + exampleName,
+                                                   dbBatchSize,
+                                                   dbBackgroundWriter);
+        pscchStats.Attach(output->Create<SlPscchUeMacStatParameters>("pscchTxUeMac"));
+        psschStats.Attach(output->Create<SlPsschUeMacStatParameters>("psschTxUeMac"));
+        pscchPhyStats.Attach(output->Create<SlRxCtrlPacketTraceParams>("pscchRxUePhy"));
+        psschPhyStats.Attach(output->Create<SlRxDataPacketTraceParams>("psschRxUePhy"));
+        pktStats.Attach(output->Create<PktTxRxRecord>("pktTxRx"));
+    };
+
+    // MAC/PHY traces reached from every device, buffered per node, instead
+    // of wildcard Config paths resolved over the whole NodeList
+    SlTraceWiring slTraces(&pscchStats, &psschStats, &pscchPhyStats, &psschPhyStats, slTraceBuffer);
+    slTraces.Connect(ueVoiceNetDev);
+
+    // Branches share the warm-up and open their own outputs; the records,
+    // KPIs and run statistics of the warm-up are dropped
+    std::unique_ptr<SlBranchPoint> branchPoint;
+    double kpiStart = realAppStart;
+    std::chrono::steady_clock::time_point runStart;
+    uint64_t eventsAtStart = 0;
+    NS_ABORT_MSG_IF(branchAt < 0 || (branchAt > 0 && Seconds(branchAt) >= finalSimTime),
+                    "branchAt must be inside (0, " << finalSimTime.GetSeconds() << ") seconds");
+    NS_ABORT_MSG_IF((branchAt > 0) == branchFile.empty(),
+                    "branchAt and branchFile must be given together");
+    if (branchAt > 0)
+    {
+        branchPoint = std::make_unique<SlBranchPoint>(
+            Seconds(branchAt),
+            SlBranchPoint::ReadBranches(branchFile),
+            branchJobs,
+            [&](const SlBranchPoint::Branch& branch) {
+                simTag += "-" + branch.tag;
+                std::string log = outputDir + simTag + ".log";
+                NS_ABORT_MSG_UNLESS(std::freopen(log.c_str(), "w", stdout),
+                                    "Cannot write " << log);
+                slTraces.Discard();
+                openOutput();
+                kpi.Clear();
+                kpiStart = std::max(realAppStart, branchAt);
+                runStart = std::chrono::steady_clock::now();
+                eventsAtStart = Simulator::GetEventCount();
+            });
     }
     else
     {
-        // Set Tx traces
-        for (uint16_t ac = 0; ac < clientApps.GetN(); ac++)
+        openOutput();
+    }
+
+    SlActivityMonitor activity;
+    if (slActivityReport)
+    {
+        activity.Connect(ueVoiceNetDev);
+    }
+
+    // Per-packet rows, can be turned off in large runs
+    if (pktTxRxRows)
+    {
+        if (!useIPv6)
         {
-            clientApps.Get(ac)->GetNode()->GetObject<Ipv6L3Protocol>()->AddMulticastAddress(
-                groupAddress6);
-            Ipv6Address localAddrs = clientApps.Get(ac)
-                                         ->GetNode()
-                                         ->GetObject<Ipv6L3Protocol>()
-                                         ->GetAddress(1, 1)
-                                         .GetAddress();
-            std::cout << "Tx address: " << localAddrs << std::endl;
-            clientApps.Get(ac)->TraceConnect("TxWithSeqTsSize",
-                                             "tx",
-                                             MakeBoundCallback(&UePacketTraceDb,
-                                                               &pktStats,
-                                                               ueVoiceContainer.Get(0),
-                                                               localAddrs));
+            // Set Tx traces
+            for (uint16_t ac = 0; ac < clientApps.GetN(); ac++)
+            {
+                Ipv4Address localAddrs = clientApps.Get(ac)
+                                             ->GetNode()
+                                             ->GetObject<Ipv4L3Protocol>()
+                                             ->GetAddress(1, 0)
+                                             .GetLocal();
+                std::cout << "Tx address: " << localAddrs << std::endl;
+                clientApps.Get(ac)->TraceConnect("TxWithSeqTsSize",
+                                                 "tx",
+                                                 MakeBoundCallback(&UePacketTraceDb,
+                                                                   &pktStats,
+                                                                   clientApps.Get(ac)->GetNode(),
+                                                                   localAddrs));
+            }
+
+            // Set Rx traces
+            for (uint16_t ac = 0; ac < serverApps.GetN(); ac++)
+            {
+                Ipv4Address localAddrs = serverApps.Get(ac)
+                                             ->GetNode()
+                                             ->GetObject<Ipv4L3Protocol>()
+                                             ->GetAddress(1, 0)
+                                             .GetLocal();
+                std::cout << "Rx address: " << localAddrs << std::endl;
+                serverApps.Get(ac)->TraceConnect("RxWithSeqTsSize",
+                                                 "rx",
+                                                 MakeBoundCallback(&UePacketTraceDb,
+                                                                   &pktStats,
+                                                                   serverApps.Get(ac)->GetNode(),
+                                                                   localAddrs));
+            }
         }
-
-        // Set Rx traces
-        for (uint16_t ac = 0; ac < serverApps.GetN(); ac++)
+        else
         {
-            serverApps.Get(ac)->GetNode()->GetObject<Ipv6L3Protocol>()->AddMulticastAddress(
-                groupAddress6);
-            Ipv6Address localAddrs = serverApps.Get(ac)
-                                         ->GetNode()
-                                         ->GetObject<Ipv6L3Protocol>()
-                                         ->GetAddress(1, 1)
-                                         .GetAddress();
-            std::cout << "Rx address: " << localAddrs << std::endl;
-            serverApps.Get(ac)->TraceConnect("RxWithSeqTsSize",
-                                             "rx",
-                                             MakeBoundCallback(&UePacketTraceDb,
-                                                               &pktStats,
-                                                               ueVoiceContainer.Get(1),
-                                                               localAddrs));
+            // Set Tx traces
+            for (uint16_t ac = 0; ac < clientApps.GetN(); ac++)
+            {
+                clientApps.Get(ac)->GetNode()->GetObject<Ipv6L3Protocol>()->AddMulticastAddress(
+                    groupAddress6);
+                Ipv6Address localAddrs = clientApps.Get(ac)
+                                             ->GetNode()
+                                             ->GetObject<Ipv6L3Protocol>()
+                                             ->GetAddress(1, 1)
+                                             .GetAddress();
+                std::cout << "Tx address: " << localAddrs << std::endl;
+                clientApps.Get(ac)->TraceConnect("TxWithSeqTsSize",
+                                                 "tx",
+                                                 MakeBoundCallback(&UePacketTraceDb,
+                                                                   &pktStats,
+                                                                   clientApps.Get(ac)->GetNode(),
+                                                                   localAddrs));
+            }
+
+            // Set Rx traces
+            for (uint16_t ac = 0; ac < serverApps.GetN(); ac++)
+            {
+                serverApps.Get(ac)->GetNode()->GetObject<Ipv6L3Protocol>()->AddMulticastAddress(
+                    groupAddress6);
+                Ipv6Address localAddrs = serverApps.Get(ac)
+                                             ->GetNode()
+                                             ->GetObject<Ipv6L3Protocol>()
+                                             ->GetAddress(1, 1)
+                                             .GetAddress();
+                std::cout << "Rx address: " << localAddrs << std::endl;
+                serverApps.Get(ac)->TraceConnect("RxWithSeqTsSize",
+                                                 "rx",
+                                                 MakeBoundCallback(&UePacketTraceDb,
+                                                                   &pktStats,
+                                                                   serverApps.Get(ac)->GetNode(),
+                                                                   localAddrs));
+            }
         }
     }
 
     Simulator::Stop(finalSimTime);
+    runStart = std::chrono::steady_clock::now();
     Simulator::Run();
+    double runSeconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+    if (branchPoint && branchPoint->IsParent())
+    {
+        std::cout << "Branches failed = " << branchPoint->GetFailures() << std::endl;
+        Simulator::Destroy();
+        return branchPoint->GetFailures() ? 1 : 0;
+    }
 
-    std::cout << "Total Tx bits = " << txByteCounter * 8 << std::endl;
-    std::cout << "Total Tx packets = " << txPktCounter << std::endl;
+    // Parsed by sweep/exp01_profile_bench.py
+    std::cout << "Diagnostics = " << EXP01_DIAGNOSTICS << std::endl;
+    uint64_t events = Simulator::GetEventCount() - eventsAtStart;
+    std::cout << "Executed events = " << events << std::endl;
+    std::cout << "Run wall clock = " << runSeconds << " sec" << std::endl;
+    std::cout << "Events per second = " << events / runSeconds << std::endl;
 
-    std::cout << "Total Rx bits = " << rxByteCounter * 8 << std::endl;
-    std::cout << "Total Rx packets = " << rxPktCounter << std::endl;
+    std::cout << "Total Tx bits = " << kpi.GetTxBytes() * 8 << std::endl;
+    std::cout << "Total Tx packets = " << kpi.GetTxPackets() << std::endl;
+
+    std::cout << "Total Rx bits = " << kpi.GetRxBytes() * 8 << std::endl;
+    std::cout << "Total Rx packets = " << kpi.GetRxPackets() << std::endl;
 
     std::cout << "Avrg thput = "
-              << (rxByteCounter * 8) / (finalSimTime - Seconds(realAppStart)).GetSeconds() / 1000.0
+              << (kpi.GetRxBytes() * 8) / (finalSimTime - Seconds(kpiStart)).GetSeconds() /
+                     1000.0
               << " kbps" << std::endl;
 
-    std::cout << "Average Packet Inter-Reception (PIR) " << pir.GetSeconds() / pirCounter << " sec"
+    std::cout << "Average Packet Inter-Reception (PIR) " << kpi.GetPir().GetMean() << " sec"
               << std::endl;
 
+    if (slEesmKernel != "stock")
+    {
+        std::cout << "EESM kernel mappings = " << SlVectorEesmIrT1::GetKernelCalls()
+                  << ", verified = " << SlVectorEesmIrT1::GetVerified()
+                  << ", mismatches = " << SlVectorEesmIrT1::GetMismatches()
+                  << ", max relative error = " << SlVectorEesmIrT1::GetMaxRelativeError()
+                  << std::endl;
+    }
+    if (cachedChannel)
+    {
+        std::cout << "Channel matrix cache hits = " << cachedChannel->GetHits()
+                  << ", misses = " << cachedChannel->GetMisses() << std::endl;
+        std::cout << "Channel condition cache hits = " << cachedCondition->GetHits()
+                  << ", misses = " << cachedCondition->GetMisses() << std::endl;
+    }
+    if (v2xWorkload)
+    {
+        std::cout << "V2X CAMs sent = " << workload.GetTxPackets(SlV2xTrafficApp::CAM)
+                  << ", received = " << workload.GetRxPackets(SlV2xTrafficApp::CAM)
+                  << "; events sent = " << workload.GetTxPackets(SlV2xTrafficApp::EVENT)
+                  << ", received = " << workload.GetRxPackets(SlV2xTrafficApp::EVENT)
+                  << std::endl;
+    }
+    if (pooledClient)
+    {
+        const SlPacketPool* pool = pooledClient->GetPool();
+        std::cout << "Packet pool size = " << (pool ? pool->GetCreated() : 0)
+                  << ", reused packets = " << (pool ? pool->GetReused() : 0) << std::endl;
+        if (SlHeapCounter::IsEnabled())
+        {
+            std::cout << "Heap allocations per packet sent (steady state) = "
+                      << (pooledClient->GetSteadySent()
+                              ? static_cast<double>(pooledClient->GetSteadyAllocations()) /
+                                    pooledClient->GetSteadySent()
+                              : 0.0)
+                      << " over " << pooledClient->GetSteadySent() << " packets" << std::endl;
+        }
+    }
+    if (lazyMobility)
+    {
+        std::cout << "Lazy mobility queries = " << Ns2LazyMobilityModel::GetQueries()
+                  << ", evaluated = " << Ns2LazyMobilityModel::GetEvaluations()
+                  << ", course changes applied = " << Ns2LazyMobilityModel::GetApplied()
+                  << std::endl;
+    }
+    if (slSensing)
+    {
+        std::cout << "Sensed PSCCHs = " << SlSensingScheduler::GetSensed()
+                  << ", candidate slots = " << SlSensingScheduler::GetCandidates()
+                  << ", excluded = " << SlSensingScheduler::GetExcluded()
+                  << ", selections without exclusion = " << SlSensingScheduler::GetFallbacks()
+                  << ", reservations beyond the horizon = " << SlSensingScheduler::GetDropped()
+                  << std::endl;
+    }
+    if (SlSpectrumArena::IsEnabled())
+    {
+        std::cout << "Spectrum arena blocks carved = " << SlSpectrumArena::GetCarved()
+                  << ", recycled = " << SlSpectrumArena::GetRecycled()
+                  << ", heap allocations in scope = " << SlSpectrumArena::GetHeapAllocations()
+                  << std::endl;
+    }
+    if (slActivityReport)
+    {
+        std::cout << "Sidelink slots per UE = " << activity.GetSlots()
+                  << ", UE slots without a PSSCH sent or received = "
+                  << activity.GetSlotsWithoutPssch() << std::endl;
+    }
+    if (proximityChannel)
+    {
+        std::cout << "Sidelink signals delivered = " << proximityChannel->GetDelivered()
+                  << ", out of range = " << proximityChannel->GetOutOfRange() << std::endl;
+    }
+
+    kpi.Write(outputDir + exampleName);
+    if (slActivityReport)
+    {
+        activity.Write(outputDir + exampleName);
+    }
+    if (v2xWorkload)
+    {
+        workload.Write(outputDir + exampleName);
+    }
+    if (regionReport)
+    {
+        regions.Write(outputDir + exampleName);
+    }
+
     /*
      * VERY IMPORTANT: Do not forget to empty the database cache, which would
      * dump the data store towards the end of the simulation in to a database.
      */
+    slTraces.Flush();
     pktStats.EmptyCache();
     pscchStats.EmptyCache();
     psschStats.EmptyCache();
     pscchPhyStats.EmptyCache();
     psschPhyStats.EmptyCache();
 
+    if (profile)
+    {
+        std::ofstream report(outputDir + simTag + "-profile.txt");
+        SimProfiler::Get().Report(report);
+        std::cout << "Profile written to " << outputDir << simTag << "-profile.txt" << std::endl;
+    }
+
     Simulator::Destroy();
 
     return 0;
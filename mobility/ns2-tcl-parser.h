@@ -0,0 +1,290 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ *
+ * Minimal, allocation-free parser for the ns-2 TCL mobility lines accepted by
+ * ns3::Ns2MobilityHelper:
+ *
+ *   $node_(i) set X_ v
+ *   $ns_ at t "$node_(i) set X_ v"
+ *   $ns_ at t "$node_(i) setdest x y speed"
+ *
+ * It works on [begin, end) ranges so it can run directly over a mmap'd file,
+ * which is not NUL terminated.
+ */
+#ifndef NS2_TCL_PARSER_H
+#define NS2_TCL_PARSER_H
+
+#include "ns2-trace-format.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace ns2trace
+{
+
+/// One parsed TCL command.
+struct TclCommand
+{
+    bool scheduled{false}; //!< true for "$ns_ at t ..." lines
+    double time{0.0};      //!< "$ns_ at" time, 0 when not scheduled
+    uint32_t nodeId{0};
+    uint16_t kind{SET_DEST}; //!< WaypointKind
+    double x{0.0};           //!< destination x or SET_* value
+    double y{0.0};
+    double speed{0.0};
+};
+
+namespace detail
+{
+
+inline const char*
+SkipBlanks(const char* p, const char* end)
+{
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    {
+        ++p;
+    }
+    return p;
+}
+
+inline bool
+Expect(const char*& p, const char* end, const char* token)
+{
+    size_t n = std::strlen(token);
+    if (static_cast<size_t>(end - p) < n || std::memcmp(p, token, n) != 0)
+    {
+        return false;
+    }
+    p += n;
+    return true;
+}
+
+/**
+ * Parse a decimal number. Numbers with up to 18 significant digits and a
+ * small exponent are converted exactly (one correctly rounded division, as
+ * in Clinger's fast path); anything else falls back to strtod on a copy.
+ */
+inline bool
+ParseDouble(const char*& p, const char* end, double& value)
+{
+    static const double pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                   1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                   1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int fraction = 0;
+    bool seenDigit = false;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        seenDigit = true;
+        if (mantissa != 0 || *p != '0')
+        {
+            ++digits;
+        }
+        mantissa = mantissa * 10 + (*p - '0');
+        ++p;
+    }
+    if (p < end && *p == '.')
+    {
+        ++p;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            seenDigit = true;
+            if (mantissa != 0 || *p != '0')
+            {
+                ++digits;
+            }
+            mantissa = mantissa * 10 + (*p - '0');
+            ++fraction;
+            ++p;
+        }
+    }
+    if (!seenDigit)
+    {
+        p = start;
+        return false;
+    }
+    bool exact = digits <= 18 && mantissa < (uint64_t(1) << 53) && fraction <= 22;
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        exact = false;
+        ++p;
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            ++p;
+        }
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            ++p;
+        }
+    }
+    if (exact)
+    {
+        value = static_cast<double>(mantissa) / pow10[fraction];
+        value = negative ? -value : value;
+        return true;
+    }
+    char buffer[64];
+    size_t n = static_cast<size_t>(p - start);
+    if (n >= sizeof(buffer))
+    {
+        p = start;
+        return false;
+    }
+    std::memcpy(buffer, start, n);
+    buffer[n] = '\0';
+    value = std::strtod(buffer, nullptr);
+    return true;
+}
+
+inline bool
+ParseNodeRef(const char*& p, const char* end, uint32_t& nodeId)
+{
+    if (!Expect(p, end, "$node_("))
+    {
+        return false;
+    }
+    uint64_t id = 0;
+    const char* digits = p;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+        id = id * 10 + (*p - '0');
+        ++p;
+    }
+    if (p == digits || id > UINT32_MAX || !Expect(p, end, ")"))
+    {
+        return false;
+    }
+    nodeId = static_cast<uint32_t>(id);
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * Parse one line.
+ * \param begin first character of the line
+ * \param end one past the last character (the newline is not required)
+ * \param cmd the parsed command
+ * \return false for blank lines, comments and anything not understood
+ */
+inline bool
+ParseTclLine(const char* begin, const char* end, TclCommand& cmd)
+{
+    using namespace detail;
+    const char* p = SkipBlanks(begin, end);
+    cmd = TclCommand();
+    if (Expect(p, end, "$ns_"))
+    {
+        p = SkipBlanks(p, end);
+        if (!Expect(p, end, "at"))
+        {
+            return false;
+        }
+        p = SkipBlanks(p, end);
+        if (!ParseDouble(p, end, cmd.time))
+        {
+            return false;
+        }
+        p = SkipBlanks(p, end);
+        if (!Expect(p, end, "\""))
+        {
+            return false;
+        }
+        cmd.scheduled = true;
+        p = SkipBlanks(p, end);
+    }
+    if (!ParseNodeRef(p, end, cmd.nodeId))
+    {
+        return false;
+    }
+    p = SkipBlanks(p, end);
+    if (Expect(p, end, "setdest"))
+    {
+        cmd.kind = SET_DEST;
+        p = SkipBlanks(p, end);
+        if (!ParseDouble(p, end, cmd.x))
+        {
+            return false;
+        }
+        p = SkipBlanks(p, end);
+        if (!ParseDouble(p, end, cmd.y))
+        {
+            return false;
+        }
+        p = SkipBlanks(p, end);
+        return ParseDouble(p, end, cmd.speed) && cmd.scheduled;
+    }
+    if (Expect(p, end, "set"))
+    {
+        p = SkipBlanks(p, end);
+        if (Expect(p, end, "X_"))
+        {
+            cmd.kind = SET_X;
+        }
+        else if (Expect(p, end, "Y_"))
+        {
+            cmd.kind = SET_Y;
+        }
+        else if (Expect(p, end, "Z_"))
+        {
+            cmd.kind = SET_Z;
+        }
+        else
+        {
+            return false;
+        }
+        p = SkipBlanks(p, end);
+        return ParseDouble(p, end, cmd.x);
+    }
+    return false;
+}
+
+/**
+ * Call \p fn(cmd, lineNumber) for every command in [begin, end).
+ * \return number of lines that looked like commands but could not be parsed
+ */
+template <typename F>
+uint64_t
+ForEachTclCommand(const char* begin, const char* end, F&& fn)
+{
+    uint64_t rejected = 0;
+    uint64_t lineNumber = 0;
+    const char* line = begin;
+    while (line < end)
+    {
+        const char* eol = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (eol == nullptr)
+        {
+            eol = end;
+        }
+        ++lineNumber;
+        TclCommand cmd;
+        if (ParseTclLine(line, eol, cmd))
+        {
+            fn(cmd, lineNumber);
+        }
+        else
+        {
+            const char* p = detail::SkipBlanks(line, eol);
+            if (p < eol && *p != '#')
+            {
+                ++rejected;
+            }
+        }
+        line = eol + 1;
+    }
+    return rejected;
+}
+
+} // namespace ns2trace
+
+#endif /* NS2_TCL_PARSER_H */
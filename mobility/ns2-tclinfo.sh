@@ -1,7 +1,17 @@
 #!/bin/bash
 # Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+#
+# Usage: ns2-tclinfo.sh <trace.tcl|trace.ns2b> [--ues=N] [--per-node]
+#
+# Runs "ns2-tcltool info" (built next to this script or found in the PATH),
+# a single pass over the trace; the awk passes below are only a fallback.
 echo -e "NS2 Mobility Trace Info - sergio.vieira@ifce.edu.br"
 echo    "==================================================="
-awk '$1 ~ /\$node_/ && !seen[$1]++ {count+=1} END{print "Nodes: " count}' $1
+tool="$(dirname "$0")/ns2-tcltool"
+[ -x "$tool" ] || tool="$(command -v ns2-tcltool)"
+if [ -n "$tool" ]; then
+    exec "$tool" info "$@"
+fi
+awk '{ while (match($0, /\$node_\([0-9]+\)/)) { id = substr($0, RSTART, RLENGTH); if (!seen[id]++) count += 1; $0 = substr($0, RSTART + RLENGTH) } } END{print "Nodes: " count}' $1
 awk -F '[()]' '$1 ~ /\$node_/ { for (i=2; i<=NF; i+=2) max = ($i > max) ? $i : max } END { print "Last Node Id: " max }' $1
-awk '$1 ~ /\$ns_/ NR==1 {start=$3} {end=$3} END { print "End time: " end}' $1
\ No newline at end of file
+awk '$1 ~ /\$ns_/ NR==1 {start=$3} {end=$3} END { print "End time: " end}' $1
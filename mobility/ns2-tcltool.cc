@@ -0,0 +1,1292 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ *
+ * Command line companion of the mobility traces used by the experiments.
+ * It does not depend on ns-3 and can be built standalone:
+ *
+ *   g++ -O2 -std=c++17 -pthread -o ns2-tcltool ns2-tcltool.cc
+ *
+ * Commands:
+ *   info <trace> [options]        node count, id gaps, time span, waypoints
+ *                                 per node, bounding box and speeds, in a
+ *                                 single pass
+ *   convert <in.tcl> <out.ns2b>   ns-2 TCL trace -> time-sorted binary trace
+ *   contacts <trace> <range> [options]
+ *                                 link up/down intervals of every node pair
+ *                                 (and fixed anchors, e.g. the gNBs) within
+ *                                 range, from the kinematics alone
+ *   compact <in> <out> [options]  drop the waypoints that do not move a node
+ *                                 farther than a tolerance from its course
+ */
+#include "ns2-tcl-parser.h"
+#include "ns2-trace-format.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <limits>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace ns2trace;
+
+namespace
+{
+
+/// Read-only memory mapping of a whole file.
+class MappedFile
+{
+  public:
+    explicit MappedFile(const std::string& filename)
+    {
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            std::fprintf(stderr, "%s: %s\n", filename.c_str(), std::strerror(errno));
+            return;
+        }
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED)
+            {
+                madvise(data, st.st_size, MADV_SEQUENTIAL);
+                m_data = static_cast<const char*>(data);
+                m_size = st.st_size;
+            }
+        }
+        m_ok = (st.st_size == 0) || (m_data != nullptr);
+        close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (m_data != nullptr)
+        {
+            munmap(const_cast<char*>(m_data), m_size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Ok() const
+    {
+        return m_ok;
+    }
+
+    const char* Begin() const
+    {
+        return m_data;
+    }
+
+    const char* End() const
+    {
+        return m_data + m_size;
+    }
+
+  private:
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    bool m_ok{false};
+};
+
+/// In-memory image of a binary trace, as produced from a TCL file.
+struct Trace
+{
+    uint32_t nodeCount{0};
+    std::vector<Ns2TraceInitialPosition> initial;
+    std::vector<Ns2TraceWaypoint> waypoints;
+};
+
+bool
+LoadTcl(const std::string& filename, Trace& trace)
+{
+    MappedFile file(filename);
+    if (!file.Ok())
+    {
+        return false;
+    }
+    std::vector<Ns2TraceInitialPosition> initialByNode;
+    uint64_t rejected =
+        ForEachTclCommand(file.Begin(), file.End(), [&](const TclCommand& cmd, uint64_t) {
+            trace.nodeCount = std::max(trace.nodeCount, cmd.nodeId + 1);
+            if (!cmd.scheduled)
+            {
+                if (initialByNode.size() <= cmd.nodeId)
+                {
+                    initialByNode.resize(cmd.nodeId + 1, Ns2TraceInitialPosition{});
+                }
+                Ns2TraceInitialPosition& pos = initialByNode[cmd.nodeId];
+                pos.nodeId = cmd.nodeId;
+                switch (cmd.kind)
+                {
+                case SET_X:
+                    pos.x = cmd.x;
+                    pos.mask |= HAS_X;
+                    break;
+                case SET_Y:
+                    pos.y = cmd.x;
+                    pos.mask |= HAS_Y;
+                    break;
+                case SET_Z:
+                    pos.z = cmd.x;
+                    pos.mask |= HAS_Z;
+                    break;
+                }
+                return;
+            }
+            Ns2TraceWaypoint wp{};
+            wp.time = cmd.time;
+            wp.nodeId = cmd.nodeId;
+            wp.kind = cmd.kind;
+            wp.x = static_cast<float>(cmd.x);
+            wp.y = static_cast<float>(cmd.y);
+            wp.speed = static_cast<float>(cmd.speed);
+            trace.waypoints.push_back(wp);
+        });
+    if (rejected > 0)
+    {
+        std::fprintf(stderr, "%s: ignored %llu unrecognized lines\n", filename.c_str(),
+                     static_cast<unsigned long long>(rejected));
+    }
+    for (const auto& pos : initialByNode)
+    {
+        if (pos.mask != 0)
+        {
+            trace.initial.push_back(pos);
+        }
+    }
+    // Ns2MobilityHelper applies the lines in file order; a stable sort keeps
+    // that order among commands sharing the same time.
+    std::stable_sort(trace.waypoints.begin(), trace.waypoints.end(),
+                     [](const Ns2TraceWaypoint& a, const Ns2TraceWaypoint& b) {
+                         return a.time < b.time;
+                     });
+    return true;
+}
+
+bool
+LoadBinary(const std::string& filename, Trace& trace)
+{
+    MappedFile file(filename);
+    if (!file.Ok())
+    {
+        return false;
+    }
+    Ns2TraceFileHeader header{};
+    size_t size = file.End() - file.Begin();
+    if (size >= sizeof(header))
+    {
+        std::memcpy(&header, file.Begin(), sizeof(header));
+    }
+    const char* problem = size < sizeof(header) ? "truncated header" : Validate(header);
+    if (problem == nullptr && size < FileSize(header))
+    {
+        problem = "truncated trace";
+    }
+    if (problem != nullptr)
+    {
+        std::fprintf(stderr, "%s: %s\n", filename.c_str(), problem);
+        return false;
+    }
+    trace.nodeCount = header.nodeCount;
+    trace.initial.resize(header.initialCount);
+    std::memcpy(trace.initial.data(), file.Begin() + InitialOffset(),
+                header.initialCount * sizeof(Ns2TraceInitialPosition));
+    trace.waypoints.resize(header.waypointCount);
+    std::memcpy(trace.waypoints.data(), file.Begin() + WaypointOffset(header),
+                header.waypointCount * sizeof(Ns2TraceWaypoint));
+    return true;
+}
+
+/// Load a TCL trace, or a binary one when the name ends in ".ns2b".
+bool
+LoadTrace(const std::string& filename, Trace& trace)
+{
+    const std::string binary = ".ns2b";
+    if (filename.size() > binary.size() &&
+        filename.compare(filename.size() - binary.size(), binary.size(), binary) == 0)
+    {
+        return LoadBinary(filename, trace);
+    }
+    return LoadTcl(filename, trace);
+}
+
+bool
+WriteBinary(const std::string& filename, const Trace& trace)
+{
+    Ns2TraceFileHeader header{};
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.byteOrder = TRACE_BYTE_ORDER;
+    header.nodeCount = trace.nodeCount;
+    header.initialCount = trace.initial.size();
+    header.waypointCount = trace.waypoints.size();
+    if (!trace.waypoints.empty())
+    {
+        header.startTime = trace.waypoints.front().time;
+        header.endTime = trace.waypoints.back().time;
+    }
+    FILE* out = std::fopen(filename.c_str(), "wb");
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "%s: %s\n", filename.c_str(), std::strerror(errno));
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, out) == 1;
+    ok = ok && std::fwrite(trace.initial.data(), sizeof(Ns2TraceInitialPosition),
+                           trace.initial.size(), out) == trace.initial.size();
+    ok = ok && std::fwrite(trace.waypoints.data(), sizeof(Ns2TraceWaypoint),
+                           trace.waypoints.size(), out) == trace.waypoints.size();
+    ok = (std::fclose(out) == 0) && ok;
+    if (!ok)
+    {
+        std::fprintf(stderr, "%s: write failed\n", filename.c_str());
+    }
+    return ok;
+}
+
+int
+Convert(int argc, char* argv[])
+{
+    if (argc != 2)
+    {
+        std::fprintf(stderr, "usage: ns2-tcltool convert <in.tcl> <out.ns2b>\n");
+        return 2;
+    }
+    Trace trace;
+    if (!LoadTcl(argv[0], trace) || !WriteBinary(argv[1], trace))
+    {
+        return 1;
+    }
+    std::printf("Nodes: %u\nInitial positions: %zu\nWaypoints: %zu\n", trace.nodeCount,
+                trace.initial.size(), trace.waypoints.size());
+    return 0;
+}
+
+/// Straight piece of the course of a node, starting at a waypoint.
+struct CourseSegment
+{
+    double start; //!< time the segment starts [s]
+    double x;     //!< position at start
+    double y;
+    double z;
+    double vx; //!< velocity until stop [m/s]
+    double vy;
+    double stop; //!< time the node stops [s]
+};
+
+/// Position of the node following \p s at time \p t >= s.start.
+void
+Position(const CourseSegment& s, double t, double& x, double& y, double& z)
+{
+    double moving = std::max(0.0, std::min(t, s.stop) - s.start);
+    x = s.x + s.vx * moving;
+    y = s.y + s.vy * moving;
+    z = s.z;
+}
+
+/**
+ * Segment after applying \p wp to a node following \p s, as replayed by
+ * Ns2MobilityHelper: "set X_" moves the node keeping its velocity,
+ * "setdest" heads for the destination from the current position and stops
+ * on arrival.
+ */
+CourseSegment
+Apply(const CourseSegment& s, const Ns2TraceWaypoint& wp)
+{
+    CourseSegment next = s;
+    double t = std::max(wp.time, s.start);
+    Position(s, t, next.x, next.y, next.z);
+    next.start = t;
+    if (wp.kind != SET_DEST)
+    {
+        double* coordinate = wp.kind == SET_X ? &next.x : wp.kind == SET_Y ? &next.y : &next.z;
+        *coordinate = wp.x;
+        next.stop = std::max(next.stop, t);
+    }
+    else if (wp.speed >= 0)
+    {
+        double dx = wp.x - next.x;
+        double dy = wp.y - next.y;
+        double distance = std::sqrt(dx * dx + dy * dy);
+        next.vx = 0;
+        next.vy = 0;
+        next.stop = t;
+        if (wp.speed > 0 && distance > 0)
+        {
+            next.vx = dx * wp.speed / distance;
+            next.vy = dy * wp.speed / distance;
+            next.stop = t + distance / wp.speed;
+        }
+    }
+    return next;
+}
+
+/// Piecewise-linear course of one node.
+class NodeCourse
+{
+  public:
+    /// \param x,y,z position at time 0
+    NodeCourse(double x, double y, double z)
+    {
+        m_segments.push_back(CourseSegment{0, x, y, z, 0, 0, 0});
+    }
+
+    /// Apply \p wp; waypoints must come in time order.
+    void Apply(const Ns2TraceWaypoint& wp)
+    {
+        m_segments.push_back(::Apply(m_segments.back(), wp));
+    }
+
+    /// Position at time \p t; calls must come in time order.
+    void At(double t, double& x, double& y, double& z)
+    {
+        while (m_cursor + 1 < m_segments.size() && m_segments[m_cursor + 1].start <= t)
+        {
+            ++m_cursor;
+        }
+        Position(m_segments[m_cursor], t, x, y, z);
+    }
+
+    /// Restart At() from time 0.
+    void Rewind()
+    {
+        m_cursor = 0;
+    }
+
+  private:
+    std::vector<CourseSegment> m_segments;
+    size_t m_cursor{0};
+};
+
+/// Fixed point with its own range, e.g. a gNB and its footprint.
+struct Anchor
+{
+    double x;
+    double y;
+    double range;
+};
+
+/// One link up interval.
+struct Contact
+{
+    uint32_t a;     //!< node id
+    uint32_t b;     //!< node id, or anchor index for anchor contacts
+    bool anchor;    //!< b is an anchor
+    double up;      //!< first sample within range [s]
+    double down;    //!< first sample out of range, or the end time [s]
+};
+
+/// Contacts of the nodes a with a % threads == part, found by one thread.
+void
+FindContacts(std::vector<NodeCourse> courses,
+             const std::vector<Anchor>& anchors,
+             double range,
+             double step,
+             double end,
+             uint32_t part,
+             uint32_t threads,
+             std::vector<Contact>& contacts)
+{
+    size_t n = courses.size();
+    std::vector<double> x(n);
+    std::vector<double> y(n);
+    std::vector<double> z(n);
+    // Uniform grid of range-sized cells, rebuilt at every sample as a
+    // counting sort: the nodes of cell c are order[first[c], first[c + 1])
+    std::vector<uint32_t> cellOf(n);
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> order(n);
+    // Open contacts of every node a with the nodes b > a and the anchors
+    // (b >= n), as (b, up time) sorted by b; merged with the neighbours
+    // found at every sample
+    std::vector<std::vector<std::pair<uint32_t, double>>> open(n);
+    std::vector<uint32_t> neighbours;
+    std::vector<std::pair<uint32_t, double>> merged;
+    auto close = [&](uint32_t a, uint32_t b, double up, double t) {
+        bool anchor = b >= n;
+        contacts.push_back(Contact{a, anchor ? static_cast<uint32_t>(b - n) : b, anchor, up, t});
+    };
+    double range2 = range * range;
+
+    uint64_t steps = static_cast<uint64_t>(std::floor(end / step + 1e-9));
+    for (uint64_t k = 0; k <= steps; ++k)
+    {
+        double t = k * step;
+        double minX = std::numeric_limits<double>::max();
+        double minY = minX;
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = maxX;
+        for (size_t i = 0; i < n; ++i)
+        {
+            courses[i].At(t, x[i], y[i], z[i]);
+            minX = std::min(minX, x[i]);
+            maxX = std::max(maxX, x[i]);
+            minY = std::min(minY, y[i]);
+            maxY = std::max(maxY, y[i]);
+        }
+        if (n == 0)
+        {
+            continue;
+        }
+        auto columns = static_cast<int64_t>((maxX - minX) / range) + 1;
+        auto rows = static_cast<int64_t>((maxY - minY) / range) + 1;
+        first.assign(columns * rows + 1, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            auto cx = static_cast<int64_t>((x[i] - minX) / range);
+            auto cy = static_cast<int64_t>((y[i] - minY) / range);
+            cellOf[i] = cy * columns + cx;
+            ++first[cellOf[i] + 1];
+        }
+        for (size_t c = 1; c < first.size(); ++c)
+        {
+            first[c] += first[c - 1];
+        }
+        std::vector<uint32_t> fill(first.begin(), first.end() - 1);
+        for (size_t i = 0; i < n; ++i)
+        {
+            order[fill[cellOf[i]]++] = i;
+        }
+
+        for (size_t a = part; a < n; a += threads)
+        {
+            neighbours.clear();
+            int64_t cx = cellOf[a] % columns;
+            int64_t cy = cellOf[a] / columns;
+            for (int64_t ny = std::max<int64_t>(cy - 1, 0); ny <= std::min(cy + 1, rows - 1); ++ny)
+            {
+                for (int64_t nx = std::max<int64_t>(cx - 1, 0);
+                     nx <= std::min(cx + 1, columns - 1);
+                     ++nx)
+                {
+                    uint32_t cell = ny * columns + nx;
+                    for (uint32_t j = first[cell]; j < first[cell + 1]; ++j)
+                    {
+                        uint32_t b = order[j];
+                        double ex = x[a] - x[b];
+                        double ey = y[a] - y[b];
+                        double ez = z[a] - z[b];
+                        if (b > a && ex * ex + ey * ey + ez * ez <= range2)
+                        {
+                            neighbours.push_back(b);
+                        }
+                    }
+                }
+            }
+            for (size_t i = 0; i < anchors.size(); ++i)
+            {
+                double ex = x[a] - anchors[i].x;
+                double ey = y[a] - anchors[i].y;
+                if (ex * ex + ey * ey <= anchors[i].range * anchors[i].range)
+                {
+                    neighbours.push_back(n + i);
+                }
+            }
+            std::sort(neighbours.begin(), neighbours.end());
+
+            auto& current = open[a];
+            merged.clear();
+            size_t i = 0;
+            for (uint32_t b : neighbours)
+            {
+                while (i < current.size() && current[i].first < b)
+                {
+                    close(a, current[i].first, current[i].second, t);
+                    ++i;
+                }
+                if (i < current.size() && current[i].first == b)
+                {
+                    merged.push_back(current[i++]);
+                }
+                else
+                {
+                    merged.emplace_back(b, t);
+                }
+            }
+            for (; i < current.size(); ++i)
+            {
+                close(a, current[i].first, current[i].second, t);
+            }
+            current.swap(merged);
+        }
+    }
+    for (size_t a = part; a < n; a += threads)
+    {
+        for (const auto& [b, up] : open[a])
+        {
+            close(a, b, up, end);
+        }
+    }
+}
+
+int
+Contacts(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr,
+                     "usage: ns2-tcltool contacts <trace.tcl|trace.ns2b> <range> [options]\n"
+                     "  --step=S           sampling step [s], default 0.1\n"
+                     "  --end=T            last sample [s], default the last waypoint\n"
+                     "  --threads=N        worker threads, default one per CPU\n"
+                     "  --anchor=X,Y[,R]   fixed anchor (e.g. a gNB) with footprint R,\n"
+                     "                     default range; repeat for several anchors\n"
+                     "  --out=FILE         contacts CSV, default contacts.csv\n");
+        return 2;
+    }
+    double range = std::atof(argv[1]);
+    double step = 0.1;
+    double end = -1;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Anchor> anchors;
+    std::string out = "contacts.csv";
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        std::string value = option.substr(option.find('=') + 1);
+        if (option.rfind("--step=", 0) == 0)
+        {
+            step = std::atof(value.c_str());
+        }
+        else if (option.rfind("--end=", 0) == 0)
+        {
+            end = std::atof(value.c_str());
+        }
+        else if (option.rfind("--threads=", 0) == 0)
+        {
+            threads = std::max(1, std::atoi(value.c_str()));
+        }
+        else if (option.rfind("--anchor=", 0) == 0)
+        {
+            Anchor anchor{0, 0, range};
+            if (std::sscanf(value.c_str(), "%lf,%lf,%lf", &anchor.x, &anchor.y, &anchor.range) <
+                2)
+            {
+                std::fprintf(stderr, "bad anchor %s, use X,Y[,R]\n", value.c_str());
+                return 2;
+            }
+            anchors.push_back(anchor);
+        }
+        else if (option.rfind("--out=", 0) == 0)
+        {
+            out = value;
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", option.c_str());
+            return 2;
+        }
+    }
+    if (!(range > 0) || !(step > 0))
+    {
+        std::fprintf(stderr, "range and step must be positive\n");
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Trace trace;
+    if (!LoadTrace(argv[0], trace))
+    {
+        return 1;
+    }
+    std::vector<NodeCourse> courses;
+    courses.reserve(trace.nodeCount);
+    for (uint32_t i = 0; i < trace.nodeCount; ++i)
+    {
+        courses.emplace_back(0, 0, 0);
+    }
+    for (const auto& pos : trace.initial)
+    {
+        courses[pos.nodeId] = NodeCourse((pos.mask & HAS_X) ? pos.x : 0,
+                                         (pos.mask & HAS_Y) ? pos.y : 0,
+                                         (pos.mask & HAS_Z) ? pos.z : 0);
+    }
+    for (const auto& wp : trace.waypoints)
+    {
+        courses[wp.nodeId].Apply(wp);
+    }
+    if (end < 0)
+    {
+        end = trace.waypoints.empty() ? 0 : trace.waypoints.back().time;
+    }
+
+    // Every thread replays all the courses (cheap) and checks its own share
+    // of the pairs, so the threads never synchronize
+    std::vector<std::vector<Contact>> found(threads);
+    std::vector<std::thread> workers;
+    for (uint32_t part = 0; part < threads; ++part)
+    {
+        workers.emplace_back(FindContacts, courses, std::cref(anchors), range, step, end, part,
+                             threads, std::ref(found[part]));
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    std::vector<Contact> contacts;
+    for (const auto& part : found)
+    {
+        contacts.insert(contacts.end(), part.begin(), part.end());
+    }
+    std::sort(contacts.begin(), contacts.end(), [](const Contact& a, const Contact& b) {
+        if (a.a != b.a)
+        {
+            return a.a < b.a;
+        }
+        if (a.anchor != b.anchor)
+        {
+            return b.anchor;
+        }
+        return a.b != b.b ? a.b < b.b : a.up < b.up;
+    });
+
+    FILE* csv = std::fopen(out.c_str(), "w");
+    if (csv == nullptr)
+    {
+        std::fprintf(stderr, "%s: %s\n", out.c_str(), std::strerror(errno));
+        return 1;
+    }
+    std::fprintf(csv, "a,b,up,down,duration\n");
+    double total = 0;
+    for (const auto& c : contacts)
+    {
+        std::fprintf(csv, "%u,%s%u,%.3f,%.3f,%.3f\n", c.a, c.anchor ? "a" : "", c.b, c.up,
+                     c.down, c.down - c.up);
+        total += c.down - c.up;
+    }
+    bool ok = std::fclose(csv) == 0;
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    std::printf("Nodes: %u\nAnchors: %zu\nSamples: %.0f\nContacts: %zu\n"
+                "Mean contact duration: %.3f s\nWall clock: %.3f s\n",
+                trace.nodeCount, anchors.size(), std::floor(end / step + 1e-9) + 1,
+                contacts.size(), contacts.empty() ? 0.0 : total / contacts.size(), wall.count());
+    return ok ? 0 : 1;
+}
+
+/// Summary of a trace, accumulated one command at a time.
+struct TraceInfo
+{
+    std::vector<uint64_t> waypoints; //!< scheduled commands, by node id
+    std::vector<bool> seen;          //!< node ids appearing in the trace
+    uint64_t setdest{0};             //!< setdest commands
+    uint64_t stops{0};               //!< setdest commands with speed 0
+    double speedSum{0};
+    double minSpeed{std::numeric_limits<double>::infinity()};
+    double maxSpeed{0};
+    double start{std::numeric_limits<double>::infinity()};
+    double end{0};
+    double minX{std::numeric_limits<double>::infinity()};
+    double maxX{-std::numeric_limits<double>::infinity()};
+    double minY{std::numeric_limits<double>::infinity()};
+    double maxY{-std::numeric_limits<double>::infinity()};
+
+    void Add(const TclCommand& cmd)
+    {
+        if (seen.size() <= cmd.nodeId)
+        {
+            seen.resize(cmd.nodeId + 1, false);
+            waypoints.resize(cmd.nodeId + 1, 0);
+        }
+        seen[cmd.nodeId] = true;
+        if (cmd.scheduled)
+        {
+            ++waypoints[cmd.nodeId];
+            start = std::min(start, cmd.time);
+            end = std::max(end, cmd.time);
+        }
+        switch (cmd.kind)
+        {
+        case SET_DEST:
+            AddX(cmd.x);
+            AddY(cmd.y);
+            ++setdest;
+            speedSum += cmd.speed;
+            minSpeed = std::min(minSpeed, cmd.speed);
+            maxSpeed = std::max(maxSpeed, cmd.speed);
+            stops += cmd.speed == 0;
+            break;
+        case SET_X:
+            AddX(cmd.x);
+            break;
+        case SET_Y:
+            AddY(cmd.x);
+            break;
+        }
+    }
+
+    void AddX(double x)
+    {
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+    }
+
+    void AddY(double y)
+    {
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+};
+
+/**
+ * Print to \p out the ids in [0, limit) for which \p select is true, as
+ * ranges ("6, 10-12"), up to 20 of them.
+ */
+template <typename F>
+void
+PrintIds(FILE* out, uint32_t limit, F&& select)
+{
+    uint32_t printed = 0;
+    uint32_t more = 0;
+    for (uint32_t id = 0; id < limit; ++id)
+    {
+        if (!select(id))
+        {
+            continue;
+        }
+        uint32_t last = id;
+        while (last + 1 < limit && select(last + 1))
+        {
+            ++last;
+        }
+        if (printed++ < 20)
+        {
+            std::fprintf(out, printed > 1 ? ", %u" : "%u", id);
+            if (last > id)
+            {
+                std::fprintf(out, "-%u", last);
+            }
+        }
+        else
+        {
+            more += last - id + 1;
+        }
+        id = last;
+    }
+    if (more > 0)
+    {
+        std::fprintf(out, " (and %u more)", more);
+    }
+    std::fprintf(out, printed == 0 ? "none\n" : "\n");
+}
+
+int
+Info(int argc, char* argv[])
+{
+    if (argc < 1)
+    {
+        std::fprintf(stderr,
+                     "usage: ns2-tcltool info <trace.tcl|trace.ns2b> [options]\n"
+                     "  --ues=N       UEs created by the experiment (ueCount), default 50\n"
+                     "  --per-node    also list the waypoints of every node\n");
+        return 2;
+    }
+    uint32_t ues = 50;
+    bool perNode = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option.rfind("--ues=", 0) == 0)
+        {
+            ues = std::strtoul(option.c_str() + 6, nullptr, 10);
+        }
+        else if (option == "--per-node")
+        {
+            perNode = true;
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", option.c_str());
+            return 2;
+        }
+    }
+
+    // One pass over the TCL text, without sorting or storing the commands;
+    // a binary trace is loaded and replayed as the equivalent commands
+    TraceInfo info;
+    uint64_t rejected = 0;
+    const std::string filename = argv[0];
+    const std::string binary = ".ns2b";
+    if (filename.size() > binary.size() &&
+        filename.compare(filename.size() - binary.size(), binary.size(), binary) == 0)
+    {
+        Trace trace;
+        if (!LoadBinary(filename, trace))
+        {
+            return 1;
+        }
+        for (const auto& pos : trace.initial)
+        {
+            const std::pair<uint32_t, double> values[] = {{HAS_X, pos.x},
+                                                          {HAS_Y, pos.y},
+                                                          {HAS_Z, pos.z}};
+            for (uint16_t kind = SET_X; kind <= SET_Z; ++kind)
+            {
+                if (pos.mask & values[kind - SET_X].first)
+                {
+                    TclCommand cmd;
+                    cmd.nodeId = pos.nodeId;
+                    cmd.kind = kind;
+                    cmd.x = values[kind - SET_X].second;
+                    info.Add(cmd);
+                }
+            }
+        }
+        for (const auto& wp : trace.waypoints)
+        {
+            TclCommand cmd;
+            cmd.scheduled = true;
+            cmd.time = wp.time;
+            cmd.nodeId = wp.nodeId;
+            cmd.kind = wp.kind;
+            cmd.x = wp.x;
+            cmd.y = wp.y;
+            cmd.speed = wp.speed;
+            info.Add(cmd);
+        }
+    }
+    else
+    {
+        MappedFile file(filename);
+        if (!file.Ok())
+        {
+            return 1;
+        }
+        rejected = ForEachTclCommand(file.Begin(), file.End(),
+                                     [&](const TclCommand& cmd, uint64_t) { info.Add(cmd); });
+    }
+
+    uint32_t ids = info.seen.size();
+    uint32_t nodes = std::count(info.seen.begin(), info.seen.end(), true);
+    uint64_t total = 0;
+    uint64_t fewest = std::numeric_limits<uint64_t>::max();
+    uint64_t most = 0;
+    for (uint32_t id = 0; id < ids; ++id)
+    {
+        if (info.seen[id])
+        {
+            total += info.waypoints[id];
+            fewest = std::min(fewest, info.waypoints[id]);
+            most = std::max(most, info.waypoints[id]);
+        }
+    }
+
+    std::printf("Nodes: %u\n", nodes);
+    if (ids > 0)
+    {
+        std::printf("Last Node Id: %u\n", ids - 1);
+    }
+    std::printf("End time: %f\n", info.end);
+    if (ids == 0)
+    {
+        return 0;
+    }
+    std::printf("Start time: %f\n", std::isinf(info.start) ? 0.0 : info.start);
+    std::printf("Missing node ids: ");
+    PrintIds(stdout, ids, [&](uint32_t id) { return !info.seen[id]; });
+    std::printf("Waypoints: %llu (per node min %llu, mean %.1f, max %llu)\n",
+                static_cast<unsigned long long>(total), static_cast<unsigned long long>(fewest),
+                static_cast<double>(total) / nodes, static_cast<unsigned long long>(most));
+    if (!std::isinf(info.minX) && !std::isinf(info.minY))
+    {
+        std::printf("Bounding box: x [%.2f, %.2f], y [%.2f, %.2f]\n", info.minX, info.maxX,
+                    info.minY, info.maxY);
+    }
+    if (info.setdest > 0)
+    {
+        std::printf("Setdest speed: min %.2f, mean %.2f, max %.2f m/s (%llu stops)\n",
+                    info.minSpeed, info.speedSum / info.setdest, info.maxSpeed,
+                    static_cast<unsigned long long>(info.stops));
+    }
+    if (rejected > 0)
+    {
+        std::printf("Unrecognized lines: %llu\n", static_cast<unsigned long long>(rejected));
+    }
+    if (perNode)
+    {
+        std::printf("\nnode waypoints\n");
+        for (uint32_t id = 0; id < ids; ++id)
+        {
+            if (info.seen[id])
+            {
+                std::printf("%4u %9llu\n", id,
+                            static_cast<unsigned long long>(info.waypoints[id]));
+            }
+        }
+    }
+
+    // The experiment creates ueCount UEs and Ns2MobilityHelper drives UE i
+    // with $node_(i): ids beyond the UEs are dropped, and UEs without an id
+    // in the trace never move
+    std::fflush(stdout);
+    if (ids > ues)
+    {
+        std::fprintf(stderr, "warning: node ids up to %u but %u UEs; ignored ids: ", ids - 1,
+                     ues);
+        PrintIds(stderr, ids, [&](uint32_t id) { return id >= ues && info.seen[id]; });
+    }
+    uint32_t idle = 0;
+    for (uint32_t id = 0; id < ues; ++id)
+    {
+        idle += id >= ids || !info.seen[id];
+    }
+    if (idle > 0)
+    {
+        std::fprintf(stderr, "warning: %u of the %u UEs have no trace entry: ", idle, ues);
+        PrintIds(stderr, ues, [&](uint32_t id) { return id >= ids || !info.seen[id]; });
+    }
+    return 0;
+}
+
+/// Largest distance between nodes following \p a and \p b during [t0, t1].
+double
+MaxDistance(const CourseSegment& a, const CourseSegment& b, double t0, double t1)
+{
+    // The distance is convex between the kinks (stops) of the two courses,
+    // so its maximum is at an end of the interval or at a stop
+    double settled = std::max(t0, std::max(a.stop, b.stop));
+    double times[] = {t0,
+                      std::min(std::max(a.stop, t0), t1),
+                      std::min(std::max(b.stop, t0), t1),
+                      std::isinf(t1) ? settled : t1};
+    double largest = 0;
+    for (double t : times)
+    {
+        double ax;
+        double ay;
+        double az;
+        double bx;
+        double by;
+        double bz;
+        Position(a, t, ax, ay, az);
+        Position(b, t, bx, by, bz);
+        double dx = ax - bx;
+        double dy = ay - by;
+        double dz = az - bz;
+        largest = std::max(largest, std::sqrt(dx * dx + dy * dy + dz * dz));
+    }
+    return largest;
+}
+
+/// \return true if nodes following \p a and \p b move the same way from \p t.
+bool
+SameMotion(const CourseSegment& a, const CourseSegment& b, double t)
+{
+    const double epsilon = 1e-9;
+    double ax;
+    double ay;
+    double az;
+    double bx;
+    double by;
+    double bz;
+    Position(a, t, ax, ay, az);
+    Position(b, t, bx, by, bz);
+    bool aMoving = a.stop > t;
+    bool bMoving = b.stop > t;
+    if (aMoving != bMoving || std::abs(ax - bx) > epsilon || std::abs(ay - by) > epsilon ||
+        std::abs(az - bz) > epsilon)
+    {
+        return false;
+    }
+    return !aMoving || (std::abs(a.vx - b.vx) <= epsilon && std::abs(a.vy - b.vy) <= epsilon &&
+                        std::abs(a.stop - b.stop) <= epsilon);
+}
+
+/// Waypoints compared after an edit before it is rejected for not resyncing.
+const size_t COMPACT_WINDOW = 64;
+
+/**
+ * Check an edit of a course against the original course.
+ *
+ * From time \p t, \p candidate follows the edited course and \p original the
+ * original one, which still has to apply waypoints[next...]. The edited course
+ * applies the same waypoints from index \p shared on. The edit is accepted if
+ * the two stay within \p tolerance until they move the same way again, which
+ * must happen within COMPACT_WINDOW waypoints, or until the end of the trace.
+ *
+ * \return the largest deviation, or infinity when the edit is rejected
+ */
+double
+Deviation(CourseSegment candidate,
+          CourseSegment original,
+          const std::vector<Ns2TraceWaypoint>& waypoints,
+          size_t next,
+          size_t shared,
+          double t,
+          double tolerance)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    double deviation = 0;
+    for (size_t j = next;; ++j)
+    {
+        if (j >= shared && SameMotion(candidate, original, t))
+        {
+            return deviation;
+        }
+        double until = j < waypoints.size() ? waypoints[j].time : infinity;
+        deviation = std::max(deviation, MaxDistance(candidate, original, t, until));
+        if (deviation > tolerance || (j >= shared && j - shared >= COMPACT_WINDOW))
+        {
+            return infinity;
+        }
+        if (j == waypoints.size())
+        {
+            return deviation;
+        }
+        original = Apply(original, waypoints[j]);
+        if (j >= shared)
+        {
+            candidate = Apply(candidate, waypoints[j]);
+        }
+        t = until;
+    }
+}
+
+/// Waypoints removed by Compact().
+struct CompactStats
+{
+    uint64_t exact{0};     //!< removed without any change of the course
+    uint64_t dropped{0};   //!< removed, the course changing within tolerance
+    uint64_t merged{0};    //!< folded into the destination of the previous setdest
+    double deviation{0};   //!< largest deviation introduced [m]
+};
+
+/**
+ * Remove the waypoints of one node that do not move it farther than
+ * \p tolerance from its original course.
+ *
+ * Every waypoint is first tried for removal; a setdest that cannot be
+ * removed is tried as the new destination of the previous kept setdest,
+ * which folds runs of collinear constant-speed setdests into one. Each edit
+ * is checked against the original course, so the deviations do not add up.
+ */
+std::vector<Ns2TraceWaypoint>
+Compact(const CourseSegment& initial,
+        const std::vector<Ns2TraceWaypoint>& waypoints,
+        double tolerance,
+        CompactStats& stats)
+{
+    std::vector<CourseSegment> original(1, initial); // course before waypoint k
+    for (const auto& wp : waypoints)
+    {
+        original.push_back(Apply(original.back(), wp));
+    }
+    std::vector<Ns2TraceWaypoint> kept;
+    CourseSegment current = initial;    // edited course after the kept waypoints
+    CourseSegment beforeLast = initial; // edited course before the last kept one
+    size_t last = 0;                    // index of the last kept waypoint
+    for (size_t k = 0; k < waypoints.size(); ++k)
+    {
+        const Ns2TraceWaypoint& wp = waypoints[k];
+        double deviation =
+            Deviation(current, original[k], waypoints, k, k + 1, wp.time, tolerance);
+        if (!std::isinf(deviation))
+        {
+            ++(deviation == 0 ? stats.exact : stats.dropped);
+            stats.deviation = std::max(stats.deviation, deviation);
+            continue;
+        }
+        if (wp.kind == SET_DEST && !kept.empty() && kept.back().kind == SET_DEST)
+        {
+            Ns2TraceWaypoint extended = kept.back();
+            extended.x = wp.x;
+            extended.y = wp.y;
+            CourseSegment candidate = Apply(beforeLast, extended);
+            deviation = Deviation(candidate, original[last + 1], waypoints, last + 1, k + 1,
+                                  extended.time, tolerance);
+            if (!std::isinf(deviation))
+            {
+                ++stats.merged;
+                stats.deviation = std::max(stats.deviation, deviation);
+                kept.back() = extended;
+                current = candidate;
+                continue;
+            }
+        }
+        beforeLast = current;
+        current = Apply(current, wp);
+        last = k;
+        kept.push_back(wp);
+    }
+    return kept;
+}
+
+bool
+WriteTcl(const std::string& filename, const Trace& trace)
+{
+    FILE* out = std::fopen(filename.c_str(), "w");
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "%s: %s\n", filename.c_str(), std::strerror(errno));
+        return false;
+    }
+    for (const auto& pos : trace.initial)
+    {
+        const char* names[] = {"X_", "Y_", "Z_"};
+        const double values[] = {pos.x, pos.y, pos.z};
+        for (int i = 0; i < 3; ++i)
+        {
+            if (pos.mask & (1u << i))
+            {
+                std::fprintf(out, "$node_(%u) set %s %.9g\n", pos.nodeId, names[i], values[i]);
+            }
+        }
+    }
+    for (const auto& wp : trace.waypoints)
+    {
+        if (wp.kind == SET_DEST)
+        {
+            std::fprintf(out, "$ns_ at %.9f \"$node_(%u) setdest %.9g %.9g %.9g\"\n", wp.time,
+                         wp.nodeId, wp.x, wp.y, wp.speed);
+        }
+        else
+        {
+            std::fprintf(out, "$ns_ at %.9f \"$node_(%u) set %s %.9g\"\n", wp.time, wp.nodeId,
+                         wp.kind == SET_X ? "X_" : wp.kind == SET_Y ? "Y_" : "Z_", wp.x);
+        }
+    }
+    bool ok = std::fclose(out) == 0;
+    if (!ok)
+    {
+        std::fprintf(stderr, "%s: write failed\n", filename.c_str());
+    }
+    return ok;
+}
+
+int
+Compact(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        std::fprintf(stderr,
+                     "usage: ns2-tcltool compact <in> <out.ns2b|out.tcl> [options]\n"
+                     "  --tolerance=M   largest deviation from the original course [m],\n"
+                     "                  default 0.1; 0 keeps the course unchanged\n");
+        return 2;
+    }
+    double tolerance = 0.1;
+    for (int i = 2; i < argc; ++i)
+    {
+        std::string option = argv[i];
+        if (option.rfind("--tolerance=", 0) == 0)
+        {
+            tolerance = std::atof(option.c_str() + 12);
+        }
+        else
+        {
+            std::fprintf(stderr, "unknown option %s\n", option.c_str());
+            return 2;
+        }
+    }
+    if (!(tolerance >= 0))
+    {
+        std::fprintf(stderr, "tolerance must not be negative\n");
+        return 2;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Trace trace;
+    if (!LoadTrace(argv[0], trace))
+    {
+        return 1;
+    }
+    std::vector<CourseSegment> initial(trace.nodeCount, CourseSegment{0, 0, 0, 0, 0, 0, 0});
+    for (const auto& pos : trace.initial)
+    {
+        initial[pos.nodeId].x = (pos.mask & HAS_X) ? pos.x : 0;
+        initial[pos.nodeId].y = (pos.mask & HAS_Y) ? pos.y : 0;
+        initial[pos.nodeId].z = (pos.mask & HAS_Z) ? pos.z : 0;
+    }
+    std::vector<std::vector<Ns2TraceWaypoint>> byNode(trace.nodeCount);
+    for (const auto& wp : trace.waypoints)
+    {
+        byNode[wp.nodeId].push_back(wp);
+    }
+    CompactStats stats;
+    size_t before = trace.waypoints.size();
+    trace.waypoints.clear();
+    for (uint32_t id = 0; id < trace.nodeCount; ++id)
+    {
+        auto kept = Compact(initial[id], byNode[id], tolerance, stats);
+        trace.waypoints.insert(trace.waypoints.end(), kept.begin(), kept.end());
+    }
+    // Only the order of the commands of a node matters, which the stable
+    // sort keeps
+    std::stable_sort(trace.waypoints.begin(), trace.waypoints.end(),
+                     [](const Ns2TraceWaypoint& a, const Ns2TraceWaypoint& b) {
+                         return a.time < b.time;
+                     });
+
+    const std::string binary = ".ns2b";
+    const std::string out = argv[1];
+    bool isBinary = out.size() > binary.size() &&
+                    out.compare(out.size() - binary.size(), binary.size(), binary) == 0;
+    if (!(isBinary ? WriteBinary(out, trace) : WriteTcl(out, trace)))
+    {
+        return 1;
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+    size_t after = trace.waypoints.size();
+    std::printf("Waypoints: %zu -> %zu (%zu events eliminated, %.1f%%)\n"
+                "  unchanged course: %llu\n  within tolerance: %llu\n"
+                "  merged into the previous setdest: %llu\n"
+                "Max deviation: %.6f m\nWall clock: %.3f s\n",
+                before, after, before - after, before ? 100.0 * (before - after) / before : 0.0,
+                static_cast<unsigned long long>(stats.exact),
+                static_cast<unsigned long long>(stats.dropped),
+                static_cast<unsigned long long>(stats.merged), stats.deviation, wall.count());
+    return 0;
+}
+
+void
+Usage()
+{
+    std::fprintf(stderr,
+                 "usage: ns2-tcltool <command> [args]\n"
+                 "  info <trace> [options]        nodes, id gaps, time span, extent, speeds\n"
+                 "  convert <in.tcl> <out.ns2b>   write a time-sorted binary trace\n"
+                 "  contacts <trace> <range> ...  link up/down intervals by distance\n"
+                 "  compact <in> <out> [options]  drop waypoints that do not change the course\n");
+}
+
+} // namespace
+
+int
+main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        Usage();
+        return 2;
+    }
+    std::string command = argv[1];
+    if (command == "info")
+    {
+        return Info(argc - 2, argv + 2);
+    }
+    if (command == "convert")
+    {
+        return Convert(argc - 2, argv + 2);
+    }
+    if (command == "compact")
+    {
+        return Compact(argc - 2, argv + 2);
+    }
+    if (command == "contacts")
+    {
+        return Contacts(argc - 2, argv + 2);
+    }
+    Usage();
+    return 2;
+}
@@ -0,0 +1,142 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ *
+ * On-disk layout of the binary ns-2 mobility trace (".ns2b").
+ *
+ * The file is produced by ns2-tcltool from an ns-2 TCL trace and read back,
+ * memory-mapped, by Ns2BinaryMobilityHelper. It is plain C++ on purpose so
+ * that both the simulator and the standalone tool can include it.
+ *
+ *   +------------------------+
+ *   | Ns2TraceFileHeader     |
+ *   +------------------------+
+ *   | Ns2TraceInitialPosition| x initialCount  (sorted by node id)
+ *   +------------------------+
+ *   | Ns2TraceWaypoint       | x waypointCount (sorted by time, stable
+ *   +------------------------+                  w.r.t. the TCL line order)
+ *
+ * Every record is 8-byte aligned, so the arrays can be used in place.
+ */
+#ifndef NS2_TRACE_FORMAT_H
+#define NS2_TRACE_FORMAT_H
+
+#include <cstdint>
+#include <cstring>
+
+namespace ns2trace
+{
+
+static const char TRACE_MAGIC[8] = {'N', 'S', '2', 'M', 'O', 'B', 'B', '\0'};
+static const uint32_t TRACE_VERSION = 1;
+static const uint32_t TRACE_BYTE_ORDER = 0x01020304;
+
+/**
+ * Kind of a waypoint record. They map one to one to the ns-2 commands
+ * understood by ns3::Ns2MobilityHelper.
+ */
+enum WaypointKind : uint16_t
+{
+    SET_DEST = 0, //!< "$node_(i) setdest x y speed"
+    SET_X = 1,    //!< "$node_(i) set X_ v", value in x
+    SET_Y = 2,    //!< "$node_(i) set Y_ v", value in x
+    SET_Z = 3,    //!< "$node_(i) set Z_ v", value in x
+};
+
+/// Bits of Ns2TraceInitialPosition::mask telling which coordinates were given.
+enum InitialMask : uint32_t
+{
+    HAS_X = 1,
+    HAS_Y = 2,
+    HAS_Z = 4,
+};
+
+struct Ns2TraceFileHeader
+{
+    char magic[8];          //!< TRACE_MAGIC
+    uint32_t version;       //!< TRACE_VERSION
+    uint32_t byteOrder;     //!< TRACE_BYTE_ORDER as written by the producer
+    uint32_t nodeCount;     //!< highest node id + 1
+    uint32_t reserved;      //!< zero
+    uint64_t initialCount;  //!< number of Ns2TraceInitialPosition records
+    uint64_t waypointCount; //!< number of Ns2TraceWaypoint records
+    double startTime;       //!< time of the first waypoint [s]
+    double endTime;         //!< time of the last waypoint [s]
+};
+
+/// "$node_(i) set X_ v" lines outside of "$ns_ at", i.e., the position at t=0.
+struct Ns2TraceInitialPosition
+{
+    uint32_t nodeId;
+    uint32_t mask; //!< InitialMask bits
+    double x;
+    double y;
+    double z;
+};
+
+/**
+ * One scheduled command. Coordinates are stored as float, which keeps
+ * sub-millimetre precision over the few kilometres spanned by our maps and
+ * is well below the two decimals printed in the TCL traces.
+ */
+struct Ns2TraceWaypoint
+{
+    double time;     //!< "$ns_ at" time [s]
+    uint32_t nodeId; //!< ns-2 node id
+    uint16_t kind;   //!< WaypointKind
+    uint16_t flags;  //!< reserved, zero
+    float x;         //!< destination x, or the value of a SET_* command
+    float y;         //!< destination y
+    float z;         //!< unused by setdest, kept for alignment
+    float speed;     //!< setdest speed [m/s]
+};
+
+static_assert(sizeof(Ns2TraceFileHeader) == 56, "unexpected header layout");
+static_assert(sizeof(Ns2TraceInitialPosition) == 32, "unexpected record layout");
+static_assert(sizeof(Ns2TraceWaypoint) == 32, "unexpected record layout");
+
+/// Byte offset of the initial positions array.
+inline uint64_t
+InitialOffset()
+{
+    return sizeof(Ns2TraceFileHeader);
+}
+
+/// Byte offset of the waypoint array.
+inline uint64_t
+WaypointOffset(const Ns2TraceFileHeader& header)
+{
+    return InitialOffset() + header.initialCount * sizeof(Ns2TraceInitialPosition);
+}
+
+/// Expected file size for \p header.
+inline uint64_t
+FileSize(const Ns2TraceFileHeader& header)
+{
+    return WaypointOffset(header) + header.waypointCount * sizeof(Ns2TraceWaypoint);
+}
+
+/**
+ * Check magic, version and byte order of \p header.
+ * \return nullptr when valid, a description of the problem otherwise
+ */
+inline const char*
+Validate(const Ns2TraceFileHeader& header)
+{
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0)
+    {
+        return "not a binary ns-2 mobility trace";
+    }
+    if (header.version != TRACE_VERSION)
+    {
+        return "unsupported binary trace version";
+    }
+    if (header.byteOrder != TRACE_BYTE_ORDER)
+    {
+        return "binary trace was written on a host with a different byte order";
+    }
+    return nullptr;
+}
+
+} // namespace ns2trace
+
+#endif /* NS2_TRACE_FORMAT_H */
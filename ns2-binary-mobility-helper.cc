@@ -0,0 +1,351 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "ns2-binary-mobility-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ns2BinaryMobilityHelper");
+
+using namespace ns2trace;
+
+Ns2MappedFile::Ns2MappedFile(const std::string& filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        NS_FATAL_ERROR("Could not open mobility trace " << filename << ": "
+                                                         << std::strerror(errno));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        NS_FATAL_ERROR("Could not stat mobility trace " << filename << ": "
+                                                         << std::strerror(errno));
+    }
+    m_size = st.st_size;
+    if (m_size > 0)
+    {
+        void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            NS_FATAL_ERROR("Could not map mobility trace " << filename << ": "
+                                                            << std::strerror(errno));
+        }
+        madvise(data, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+    }
+    close(fd);
+    m_released = m_data;
+}
+
+Ns2MappedFile::~Ns2MappedFile()
+{
+    if (m_data != nullptr)
+    {
+        munmap(const_cast<char*>(m_data), m_size);
+    }
+}
+
+const char*
+Ns2MappedFile::Begin() const
+{
+    return m_data;
+}
+
+const char*
+Ns2MappedFile::End() const
+{
+    return m_data + m_size;
+}
+
+size_t
+Ns2MappedFile::GetSize() const
+{
+    return m_size;
+}
+
+void
+Ns2MappedFile::Release(const char* upTo)
+{
+    static const size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t offset = static_cast<size_t>(upTo - m_data) / pageSize * pageSize;
+    const char* limit = m_data + offset;
+    if (limit > m_released)
+    {
+        madvise(const_cast<char*>(m_released), limit - m_released, MADV_DONTNEED);
+        m_released = limit;
+    }
+}
+
+Ns2BinaryTrace::Ns2BinaryTrace(const std::string& filename)
+    : m_file(filename)
+{
+    if (m_file.GetSize() < sizeof(Ns2TraceFileHeader))
+    {
+        NS_FATAL_ERROR("Binary mobility trace " << filename << " is truncated");
+    }
+    const char* error = Validate(GetHeader());
+    if (error != nullptr)
+    {
+        NS_FATAL_ERROR(filename << ": " << error);
+    }
+    if (FileSize(GetHeader()) != m_file.GetSize())
+    {
+        NS_FATAL_ERROR("Binary mobility trace " << filename << " is truncated");
+    }
+    NS_LOG_INFO("Mapped " << filename << ": " << GetHeader().nodeCount << " nodes, "
+                          << GetHeader().waypointCount << " waypoints");
+}
+
+const Ns2TraceFileHeader&
+Ns2BinaryTrace::GetHeader() const
+{
+    return *reinterpret_cast<const Ns2TraceFileHeader*>(m_file.Begin());
+}
+
+const Ns2TraceInitialPosition*
+Ns2BinaryTrace::InitialBegin() const
+{
+    return reinterpret_cast<const Ns2TraceInitialPosition*>(m_file.Begin() + InitialOffset());
+}
+
+const Ns2TraceInitialPosition*
+Ns2BinaryTrace::InitialEnd() const
+{
+    return InitialBegin() + GetHeader().initialCount;
+}
+
+const Ns2TraceWaypoint*
+Ns2BinaryTrace::WaypointsBegin() const
+{
+    return reinterpret_cast<const Ns2TraceWaypoint*>(m_file.Begin() +
+                                                     WaypointOffset(GetHeader()));
+}
+
+const Ns2TraceWaypoint*
+Ns2BinaryTrace::WaypointsEnd() const
+{
+    return WaypointsBegin() + GetHeader().waypointCount;
+}
+
+void
+Ns2BinaryTrace::Release(const Ns2TraceWaypoint* upTo)
+{
+    // the header lives in the first page, keep it
+    if (reinterpret_cast<const char*>(upTo) - m_file.Begin() > sysconf(_SC_PAGESIZE))
+    {
+        m_file.Release(reinterpret_cast<const char*>(upTo));
+    }
+}
+
+static void
+SetPosition(Ptr<ConstantVelocityMobilityModel> model, Vector position)
+{
+    model->SetPosition(position);
+}
+
+void
+Ns2NodeCourse::Attach(Ptr<Node> node, bool lazy)
+{
+    if (lazy)
+    {
+        m_lazy = node->GetObject<Ns2LazyMobilityModel>();
+        if (!m_lazy)
+        {
+            m_lazy = CreateObject<Ns2LazyMobilityModel>();
+            node->AggregateObject(m_lazy);
+        }
+        return;
+    }
+    m_model = node->GetObject<ConstantVelocityMobilityModel>();
+    if (!m_model)
+    {
+        m_model = CreateObject<ConstantVelocityMobilityModel>();
+        node->AggregateObject(m_model);
+    }
+}
+
+bool
+Ns2NodeCourse::IsAttached() const
+{
+    return m_model || m_lazy;
+}
+
+void
+Ns2NodeCourse::SetInitialPosition(const Ns2TraceInitialPosition& pos)
+{
+    Ptr<MobilityModel> model = m_lazy ? Ptr<MobilityModel>(m_lazy) : m_model;
+    Vector position = model->GetPosition();
+    position.x = (pos.mask & HAS_X) ? pos.x : position.x;
+    position.y = (pos.mask & HAS_Y) ? pos.y : position.y;
+    position.z = (pos.mask & HAS_Z) ? pos.z : position.z;
+    model->SetPosition(position);
+    m_finalPosition = position;
+}
+
+EventId
+Ns2NodeCourse::SetVelocityIn(Time at, const Vector& velocity)
+{
+    if (m_lazy)
+    {
+        m_lazyStop = m_lazy->AddVelocity(Simulator::Now() + at, velocity);
+        return EventId();
+    }
+    return Simulator::Schedule(at, &ConstantVelocityMobilityModel::SetVelocity, m_model, velocity);
+}
+
+void
+Ns2NodeCourse::CancelStop()
+{
+    m_stopEvent.Cancel();
+    if (m_lazyStopPending)
+    {
+        m_lazy->Cancel(m_lazyStop);
+    }
+    m_lazyStopPending = false;
+}
+
+void
+Ns2NodeCourse::Apply(const Ns2TraceWaypoint& wp)
+{
+    Time at = Seconds(wp.time) - Simulator::Now();
+    if (at.IsNegative())
+    {
+        at = Time(0);
+    }
+    if (wp.kind != SET_DEST)
+    {
+        Vector position = m_lazy ? m_lazy->GetPosition() : m_model->GetPosition();
+        if (wp.kind == SET_X)
+        {
+            position.x = wp.x;
+        }
+        else if (wp.kind == SET_Y)
+        {
+            position.y = wp.x;
+        }
+        else
+        {
+            position.z = wp.x;
+        }
+        if (m_lazy)
+        {
+            m_lazy->AddPosition(Simulator::Now() + at, position);
+        }
+        else
+        {
+            Simulator::Schedule(at, &SetPosition, m_model, position);
+        }
+        m_finalPosition = position;
+        return;
+    }
+
+    if (m_targetArrivalTime > wp.time)
+    {
+        // the previous destination was not reached, start from where we are
+        double travelled = wp.time - m_travelStartTime;
+        m_finalPosition = Vector(m_startPosition.x + m_speed.x * travelled,
+                                 m_startPosition.y + m_speed.y * travelled,
+                                 0);
+        CancelStop();
+    }
+
+    Vector last = m_finalPosition;
+    m_startPosition = last;
+    m_travelStartTime = wp.time;
+    m_targetArrivalTime = wp.time;
+    m_speed = Vector();
+    m_stopEvent = EventId();
+    m_lazyStopPending = false;
+    if (wp.speed == 0)
+    {
+        m_stopEvent = SetVelocityIn(at, Vector(0, 0, 0));
+        m_lazyStopPending = bool(m_lazy);
+        return;
+    }
+    if (wp.speed < 0)
+    {
+        return;
+    }
+    double dx = wp.x - last.x;
+    double dy = wp.y - last.y;
+    double time = std::sqrt(dx * dx + dy * dy) / wp.speed;
+    if (time == 0)
+    {
+        return;
+    }
+    m_speed = Vector(dx / time, dy / time, 0);
+    SetVelocityIn(at, m_speed);
+    m_stopEvent = SetVelocityIn(at + Seconds(time), Vector(0, 0, 0));
+    m_lazyStopPending = bool(m_lazy);
+    m_finalPosition = Vector(wp.x, wp.y, last.z);
+    m_targetArrivalTime += time;
+}
+
+Ns2BinaryMobilityHelper::Ns2BinaryMobilityHelper(std::string filename)
+    : m_filename(filename)
+{
+}
+
+void
+Ns2BinaryMobilityHelper::SetLazy(bool lazy)
+{
+    m_lazy = lazy;
+}
+
+void
+Ns2BinaryMobilityHelper::Install() const
+{
+    Install(NodeList::Begin(), NodeList::End());
+}
+
+void
+Ns2BinaryMobilityHelper::DoInstall(const std::vector<Ptr<Node>>& nodes) const
+{
+    Ptr<Ns2BinaryTrace> trace = Create<Ns2BinaryTrace>(m_filename);
+    uint32_t nodeCount = std::min<uint32_t>(trace->GetHeader().nodeCount, nodes.size());
+    std::vector<Ns2NodeCourse> courses(nodeCount);
+    for (uint32_t i = 0; i < nodeCount; ++i)
+    {
+        courses[i].Attach(nodes[i], m_lazy);
+    }
+
+    for (auto it = trace->InitialBegin(); it != trace->InitialEnd(); ++it)
+    {
+        if (it->nodeId < nodeCount)
+        {
+            courses[it->nodeId].SetInitialPosition(*it);
+        }
+    }
+
+    uint64_t skipped = 0;
+    for (auto it = trace->WaypointsBegin(); it != trace->WaypointsEnd(); ++it)
+    {
+        if (it->nodeId >= nodeCount)
+        {
+            ++skipped;
+            continue;
+        }
+        courses[it->nodeId].Apply(*it);
+    }
+    NS_LOG_INFO("Installed " << trace->GetHeader().waypointCount - skipped << " waypoints on "
+                             << nodeCount << " nodes, " << skipped << " ignored");
+}
+
+} // namespace ns3
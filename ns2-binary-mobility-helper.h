@@ -0,0 +1,220 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef NS2_BINARY_MOBILITY_HELPER_H
+#define NS2_BINARY_MOBILITY_HELPER_H
+
+#include "mobility/ns2-trace-format.h"
+#include "ns2-lazy-mobility-model.h"
+
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/vector.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Read-only memory mapping of a whole file.
+ *
+ * Pages that were already consumed can be handed back to the kernel with
+ * Release(), which keeps the resident size flat while a long trace is
+ * streamed.
+ */
+class Ns2MappedFile
+{
+  public:
+    /**
+     * Map \p filename. Aborts the simulation if it cannot be opened.
+     * \param filename path of the file
+     */
+    explicit Ns2MappedFile(const std::string& filename);
+    ~Ns2MappedFile();
+
+    Ns2MappedFile(const Ns2MappedFile&) = delete;
+    Ns2MappedFile& operator=(const Ns2MappedFile&) = delete;
+
+    /// \return first byte of the file
+    const char* Begin() const;
+    /// \return one past the last byte of the file
+    const char* End() const;
+    /// \return the file size in bytes
+    size_t GetSize() const;
+    /**
+     * Drop the resident pages that lie entirely before \p upTo. They are
+     * read back from the file if touched again.
+     * \param upTo first byte still needed
+     */
+    void Release(const char* upTo);
+
+  private:
+    const char* m_data{nullptr};     //!< start of the mapping
+    size_t m_size{0};                //!< length of the mapping
+    const char* m_released{nullptr}; //!< everything before this was released
+};
+
+/**
+ * \brief Memory-mapped binary ns-2 mobility trace (".ns2b").
+ *
+ * The file is produced by mobility/ns2-tcltool from the TCL trace. Records
+ * are used in place, nothing is copied. The trace is reference counted so
+ * that it outlives the helpers while events still need it.
+ */
+class Ns2BinaryTrace : public SimpleRefCount<Ns2BinaryTrace>
+{
+  public:
+    /**
+     * Map \p filename. Aborts the simulation if the file is missing or is
+     * not a valid binary trace.
+     * \param filename path of the .ns2b file
+     */
+    explicit Ns2BinaryTrace(const std::string& filename);
+
+    /// \return the file header
+    const ns2trace::Ns2TraceFileHeader& GetHeader() const;
+    /// \return first initial position record
+    const ns2trace::Ns2TraceInitialPosition* InitialBegin() const;
+    /// \return one past the last initial position record
+    const ns2trace::Ns2TraceInitialPosition* InitialEnd() const;
+    /// \return first waypoint, waypoints are sorted by time
+    const ns2trace::Ns2TraceWaypoint* WaypointsBegin() const;
+    /// \return one past the last waypoint
+    const ns2trace::Ns2TraceWaypoint* WaypointsEnd() const;
+    /**
+     * Release the pages holding the waypoints before \p upTo.
+     * \param upTo first waypoint still needed
+     */
+    void Release(const ns2trace::Ns2TraceWaypoint* upTo);
+
+  private:
+    Ns2MappedFile m_file; //!< the mapping
+};
+
+/**
+ * \brief Movement of one trace node.
+ *
+ * Keeps the bookkeeping of the last setdest (the DestinationPoint of
+ * Ns2MobilityHelper) and schedules the SetVelocity / SetPosition events of
+ * each command exactly as Ns2MobilityHelper does, or, when attached lazily,
+ * records them in an Ns2LazyMobilityModel without scheduling anything.
+ * Commands must be applied in time order, but can be applied at any time
+ * before they are due.
+ */
+class Ns2NodeCourse
+{
+  public:
+    /**
+     * Aggregate a ConstantVelocityMobilityModel (or, with \p lazy, an
+     * Ns2LazyMobilityModel) to \p node, unless it already has one, and
+     * drive that model.
+     * \param node the node mapped to this trace node
+     * \param lazy record the course instead of scheduling events
+     */
+    void Attach(Ptr<Node> node, bool lazy = false);
+    /// \return true if Attach was called
+    bool IsAttached() const;
+    /**
+     * Apply an initial "$node_(i) set X_ v" position.
+     * \param pos the initial position record
+     */
+    void SetInitialPosition(const ns2trace::Ns2TraceInitialPosition& pos);
+    /**
+     * Schedule the events of a trace command.
+     * \param wp the command
+     */
+    void Apply(const ns2trace::Ns2TraceWaypoint& wp);
+
+  private:
+    /**
+     * \param at delay of the change
+     * \param velocity the new velocity
+     * \return the event of the change, invalid when recorded lazily
+     */
+    EventId SetVelocityIn(Time at, const Vector& velocity);
+
+    /// Cancel the stop of the current segment.
+    void CancelStop();
+
+    Ptr<ConstantVelocityMobilityModel> m_model; //!< model driven by the trace
+    Ptr<Ns2LazyMobilityModel> m_lazy;           //!< or the lazy model
+    Vector m_startPosition;                     //!< start of the current segment
+    Vector m_finalPosition;                     //!< end of the current segment
+    Vector m_speed;                             //!< velocity of the current segment
+    double m_travelStartTime{0.0};              //!< start time of the segment [s]
+    double m_targetArrivalTime{0.0};            //!< expected arrival time [s]
+    EventId m_stopEvent;                        //!< SetVelocity(0) at arrival
+    uint32_t m_lazyStop{0};                     //!< id of the lazy SetVelocity(0)
+    bool m_lazyStopPending{false};              //!< m_lazyStop may be cancelled
+};
+
+/**
+ * \brief Install the movements of a binary ns-2 trace onto a set of nodes.
+ *
+ * Drop-in replacement of Ns2MobilityHelper for traces converted with
+ * "ns2-tcltool convert". The semantics of setdest and set X_/Y_/Z_ are the
+ * same as in Ns2MobilityHelper (a ConstantVelocityMobilityModel is
+ * aggregated to each node and driven by SetVelocity events), but the trace is
+ * read from a memory-mapped, time-sorted array instead of being parsed from
+ * text, so the start-up cost no longer depends on the text size.
+ *
+ * As in Ns2MobilityHelper, trace node i is mapped to the i-th node of the
+ * range given to Install; trace nodes without a matching node are ignored.
+ */
+class Ns2BinaryMobilityHelper
+{
+  public:
+    /**
+     * \param filename path of the .ns2b file
+     */
+    Ns2BinaryMobilityHelper(std::string filename);
+
+    /**
+     * \param lazy drive an Ns2LazyMobilityModel, which records the course,
+     * instead of a ConstantVelocityMobilityModel driven by events
+     */
+    void SetLazy(bool lazy);
+
+    /**
+     * Install the movements on the nodes of NodeList.
+     */
+    void Install() const;
+
+    /**
+     * \param begin an iterator to the first node
+     * \param end an iterator past the last node
+     */
+    template <typename T>
+    void Install(T begin, T end) const;
+
+  private:
+    /**
+     * \param nodes nodes indexed by trace node id
+     */
+    void DoInstall(const std::vector<Ptr<Node>>& nodes) const;
+
+    std::string m_filename; //!< path of the binary trace
+    bool m_lazy{false};     //!< record the courses in Ns2LazyMobilityModel
+};
+
+template <typename T>
+void
+Ns2BinaryMobilityHelper::Install(T begin, T end) const
+{
+    std::vector<Ptr<Node>> nodes;
+    for (T i = begin; i != end; ++i)
+    {
+        nodes.push_back(*i);
+    }
+    DoInstall(nodes);
+}
+
+} // namespace ns3
+
+#endif /* NS2_BINARY_MOBILITY_HELPER_H */
@@ -0,0 +1,207 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "ns2-lazy-mobility-model.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ns2LazyMobilityModel");
+
+NS_OBJECT_ENSURE_REGISTERED(Ns2LazyMobilityModel);
+
+uint64_t Ns2LazyMobilityModel::s_queries = 0;
+uint64_t Ns2LazyMobilityModel::s_evaluations = 0;
+uint64_t Ns2LazyMobilityModel::s_applied = 0;
+
+TypeId
+Ns2LazyMobilityModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::Ns2LazyMobilityModel")
+            .SetParent<MobilityModel>()
+            .SetGroupName("Mobility")
+            .AddConstructor<Ns2LazyMobilityModel>()
+            .AddAttribute("NotifyCourseChanges",
+                          "Fire CourseChange at every recorded change, with one event each",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ns2LazyMobilityModel::m_notify),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+Ns2LazyMobilityModel::Ns2LazyMobilityModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ns2LazyMobilityModel::~Ns2LazyMobilityModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+Ns2LazyMobilityModel::AddVelocity(Time at, const Vector& velocity)
+{
+    uint32_t id = m_nextId++;
+    Insert(Change{at.GetTimeStep(), id, true, false, velocity});
+    return id;
+}
+
+void
+Ns2LazyMobilityModel::AddPosition(Time at, const Vector& position)
+{
+    Insert(Change{at.GetTimeStep(), m_nextId++, false, false, position});
+}
+
+void
+Ns2LazyMobilityModel::Insert(const Change& change)
+{
+    NS_ABORT_MSG_IF(change.ts < Simulator::Now().GetTimeStep(), "Course change in the past");
+    auto it = std::upper_bound(m_changes.begin() + m_next,
+                               m_changes.end(),
+                               change.ts,
+                               [](int64_t ts, const Change& c) { return ts < c.ts; });
+    it = m_changes.insert(it, change);
+    m_memoTs = -1;
+    if (m_notify && IsInitialized())
+    {
+        it->notify = Simulator::Schedule(TimeStep(change.ts) - Simulator::Now(),
+                                         &Ns2LazyMobilityModel::NotifyCourseChange,
+                                         this);
+    }
+}
+
+void
+Ns2LazyMobilityModel::Cancel(uint32_t id)
+{
+    // From the back: the change cancelled is usually the last one recorded
+    for (size_t i = m_changes.size(); i > m_next; --i)
+    {
+        Change& change = m_changes[i - 1];
+        if (change.id == id)
+        {
+            change.cancelled = true;
+            change.notify.Cancel();
+            m_memoTs = -1;
+            return;
+        }
+    }
+}
+
+void
+Ns2LazyMobilityModel::DoInitialize()
+{
+    // Changes recorded before the start; the later ones schedule their own
+    if (m_notify)
+    {
+        for (size_t i = m_next; i < m_changes.size(); ++i)
+        {
+            if (!m_changes[i].cancelled)
+            {
+                m_changes[i].notify =
+                    Simulator::Schedule(TimeStep(m_changes[i].ts) - Simulator::Now(),
+                                        &Ns2LazyMobilityModel::NotifyCourseChange,
+                                        this);
+            }
+        }
+    }
+    MobilityModel::DoInitialize();
+}
+
+void
+Ns2LazyMobilityModel::Update() const
+{
+    ++s_queries;
+    int64_t now = Simulator::Now().GetTimeStep();
+    if (now == m_memoTs)
+    {
+        return;
+    }
+    ++s_evaluations;
+    while (m_next < m_changes.size() && m_changes[m_next].ts <= now)
+    {
+        const Change& change = m_changes[m_next++];
+        if (change.cancelled)
+        {
+            continue;
+        }
+        double elapsed = TimeStep(change.ts - m_since).GetSeconds();
+        m_position.x += m_velocity.x * elapsed;
+        m_position.y += m_velocity.y * elapsed;
+        m_position.z += m_velocity.z * elapsed;
+        m_since = change.ts;
+        if (change.isVelocity)
+        {
+            m_velocity = change.value;
+        }
+        else
+        {
+            m_position = change.value;
+        }
+        ++s_applied;
+    }
+    // Drop the applied changes once they are half of the vector, so memory
+    // follows the changes still to come, as with one event per change
+    if (m_next > m_changes.size() / 2)
+    {
+        m_changes.erase(m_changes.begin(), m_changes.begin() + m_next);
+        m_next = 0;
+    }
+    double elapsed = TimeStep(now - m_since).GetSeconds();
+    m_memoPosition = Vector(m_position.x + m_velocity.x * elapsed,
+                            m_position.y + m_velocity.y * elapsed,
+                            m_position.z + m_velocity.z * elapsed);
+    m_memoTs = now;
+}
+
+Vector
+Ns2LazyMobilityModel::DoGetPosition() const
+{
+    Update();
+    return m_memoPosition;
+}
+
+Vector
+Ns2LazyMobilityModel::DoGetVelocity() const
+{
+    Update();
+    return m_velocity;
+}
+
+void
+Ns2LazyMobilityModel::DoSetPosition(const Vector& position)
+{
+    Update();
+    m_position = position;
+    m_since = Simulator::Now().GetTimeStep();
+    m_memoPosition = position;
+    NotifyCourseChange();
+}
+
+uint64_t
+Ns2LazyMobilityModel::GetQueries()
+{
+    return s_queries;
+}
+
+uint64_t
+Ns2LazyMobilityModel::GetEvaluations()
+{
+    return s_evaluations;
+}
+
+uint64_t
+Ns2LazyMobilityModel::GetApplied()
+{
+    return s_applied;
+}
+
+} // namespace ns3
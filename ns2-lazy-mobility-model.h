@@ -0,0 +1,121 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef NS2_LAZY_MOBILITY_MODEL_H
+#define NS2_LAZY_MOBILITY_MODEL_H
+
+#include "ns3/event-id.h"
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Constant velocity mobility whose course is known in advance.
+ *
+ * Ns2NodeCourse records the velocity and position changes of a trace node
+ * here instead of scheduling a SetVelocity / SetPosition event for each of
+ * them. Nothing is computed while the simulation runs until the position or
+ * the velocity is asked for: the changes due by then are applied, and the
+ * result is kept for the rest of the timestep, so the cost follows the
+ * queries, not the density of the trace.
+ *
+ * The CourseChange trace is not fired by the recorded changes unless
+ * NotifyCourseChanges is set, which schedules one (cheap) event per change;
+ * consumers that track positions through CourseChange, such as
+ * SlProximityGrid, need it.
+ */
+class Ns2LazyMobilityModel : public MobilityModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    Ns2LazyMobilityModel();
+    ~Ns2LazyMobilityModel() override;
+
+    /**
+     * Record a velocity change.
+     * \param at absolute time of the change, not in the past
+     * \param velocity the new velocity
+     * \return id of the change, for Cancel()
+     */
+    uint32_t AddVelocity(Time at, const Vector& velocity);
+
+    /**
+     * Record a position change; the velocity is kept.
+     * \param at absolute time of the change, not in the past
+     * \param position the new position
+     */
+    void AddPosition(Time at, const Vector& position);
+
+    /**
+     * Drop a recorded change that is not due yet.
+     * \param id the id returned by AddVelocity()
+     */
+    void Cancel(uint32_t id);
+
+    /// \return position and velocity queries of all the instances
+    static uint64_t GetQueries();
+
+    /// \return queries of all the instances not answered by the memo
+    static uint64_t GetEvaluations();
+
+    /// \return recorded changes applied by all the instances
+    static uint64_t GetApplied();
+
+  protected:
+    void DoInitialize() override;
+
+  private:
+    Vector DoGetPosition() const override;
+    void DoSetPosition(const Vector& position) override;
+    Vector DoGetVelocity() const override;
+
+    /// One recorded change.
+    struct Change
+    {
+        int64_t ts;      //!< time step of the change
+        uint32_t id;     //!< id returned to the caller
+        bool isVelocity; //!< velocity, else position
+        bool cancelled;  //!< dropped by Cancel()
+        Vector value;    //!< the new velocity or position
+        EventId notify;  //!< its CourseChange event, with NotifyCourseChanges
+    };
+
+    /**
+     * Insert \p change after the changes of the same time, and after those
+     * already applied.
+     * \param change the change
+     */
+    void Insert(const Change& change);
+
+    /// Apply the changes due now and update the memo.
+    void Update() const;
+
+    bool m_notify{false}; //!< schedule CourseChange events
+
+    mutable std::vector<Change> m_changes; //!< changes, sorted by time
+    uint32_t m_nextId{0};                  //!< id of the next change
+    mutable size_t m_next{0};              //!< first change not applied
+    mutable Vector m_position;             //!< position at m_since
+    mutable Vector m_velocity;             //!< current velocity
+    mutable int64_t m_since{0};            //!< time step of m_position
+    mutable int64_t m_memoTs{-1};          //!< time step of the memo
+    mutable Vector m_memoPosition;         //!< position at m_memoTs
+
+    static uint64_t s_queries;     //!< position and velocity queries
+    static uint64_t s_evaluations; //!< queries not answered by the memo
+    static uint64_t s_applied;     //!< changes applied
+};
+
+} // namespace ns3
+
+#endif /* NS2_LAZY_MOBILITY_MODEL_H */
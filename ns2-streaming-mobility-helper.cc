@@ -0,0 +1,295 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "ns2-streaming-mobility-helper.h"
+
+#include "mobility/ns2-tcl-parser.h"
+#include "ns2-binary-mobility-helper.h"
+
+#include "ns3/log.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("Ns2StreamingMobilityHelper");
+
+using namespace ns2trace;
+
+namespace
+{
+
+/// Sequential reader of trace commands.
+class WaypointSource : public SimpleRefCount<WaypointSource>
+{
+  public:
+    virtual ~WaypointSource() = default;
+    /**
+     * \param positions filled with the initial positions
+     */
+    virtual void ReadInitialPositions(std::vector<Ns2TraceInitialPosition>& positions) = 0;
+    /**
+     * \param wp filled with the next command
+     * \return false at the end of the trace
+     */
+    virtual bool Next(Ns2TraceWaypoint& wp) = 0;
+    /// Give back the memory of the commands already returned.
+    virtual void ReleaseConsumed() = 0;
+};
+
+class BinarySource : public WaypointSource
+{
+  public:
+    BinarySource(const std::string& filename)
+        : m_trace(Create<Ns2BinaryTrace>(filename)),
+          m_cursor(m_trace->WaypointsBegin())
+    {
+    }
+
+    void ReadInitialPositions(std::vector<Ns2TraceInitialPosition>& positions) override
+    {
+        positions.assign(m_trace->InitialBegin(), m_trace->InitialEnd());
+    }
+
+    bool Next(Ns2TraceWaypoint& wp) override
+    {
+        if (m_cursor == m_trace->WaypointsEnd())
+        {
+            return false;
+        }
+        wp = *m_cursor++;
+        return true;
+    }
+
+    void ReleaseConsumed() override
+    {
+        m_trace->Release(m_cursor);
+    }
+
+  private:
+    Ptr<Ns2BinaryTrace> m_trace;      //!< mapped trace
+    const Ns2TraceWaypoint* m_cursor; //!< next waypoint to return
+};
+
+class TclSource : public WaypointSource
+{
+  public:
+    TclSource(const std::string& filename)
+        : m_filename(filename),
+          m_file(filename),
+          m_cursor(m_file.Begin())
+    {
+    }
+
+    void ReadInitialPositions(std::vector<Ns2TraceInitialPosition>& positions) override
+    {
+        positions.clear();
+        TclCommand cmd;
+        const char* line = m_cursor;
+        while (NextCommand(line, cmd) && !cmd.scheduled)
+        {
+            m_cursor = line;
+            if (positions.size() <= cmd.nodeId)
+            {
+                positions.resize(cmd.nodeId + 1, Ns2TraceInitialPosition{});
+            }
+            Ns2TraceInitialPosition& pos = positions[cmd.nodeId];
+            pos.nodeId = cmd.nodeId;
+            switch (cmd.kind)
+            {
+            case SET_X:
+                pos.x = cmd.x;
+                pos.mask |= HAS_X;
+                break;
+            case SET_Y:
+                pos.y = cmd.x;
+                pos.mask |= HAS_Y;
+                break;
+            case SET_Z:
+                pos.z = cmd.x;
+                pos.mask |= HAS_Z;
+                break;
+            }
+        }
+    }
+
+    bool Next(Ns2TraceWaypoint& wp) override
+    {
+        TclCommand cmd;
+        if (!NextCommand(m_cursor, cmd))
+        {
+            return false;
+        }
+        if (!cmd.scheduled)
+        {
+            NS_FATAL_ERROR(m_filename << ": initial position of node " << cmd.nodeId
+                                      << " after the first $ns_ at line; convert the trace "
+                                         "with ns2-tcltool to stream it");
+        }
+        if (cmd.time < m_lastTime)
+        {
+            NS_FATAL_ERROR(m_filename << ": not sorted by time at t=" << cmd.time
+                                      << "; convert the trace with ns2-tcltool to stream it");
+        }
+        m_lastTime = cmd.time;
+        wp = Ns2TraceWaypoint{};
+        wp.time = cmd.time;
+        wp.nodeId = cmd.nodeId;
+        wp.kind = cmd.kind;
+        wp.x = static_cast<float>(cmd.x);
+        wp.y = static_cast<float>(cmd.y);
+        wp.speed = static_cast<float>(cmd.speed);
+        return true;
+    }
+
+    void ReleaseConsumed() override
+    {
+        m_file.Release(m_cursor);
+    }
+
+  private:
+    /**
+     * Parse the command at or after \p line, skipping what is not understood.
+     * \param line in: where to start, out: start of the following line
+     * \param cmd the parsed command
+     * \return false at the end of the file
+     */
+    bool NextCommand(const char*& line, TclCommand& cmd) const
+    {
+        const char* end = m_file.End();
+        while (line < end)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            eol = (eol == nullptr) ? end : eol;
+            bool ok = ParseTclLine(line, eol, cmd);
+            line = (eol == end) ? end : eol + 1;
+            if (ok)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string m_filename; //!< for error messages
+    Ns2MappedFile m_file;   //!< mapped text
+    const char* m_cursor;   //!< start of the next line to parse
+    double m_lastTime{0.0}; //!< time of the last command returned
+};
+
+/// State shared by the refill events.
+struct Stream : public SimpleRefCount<Stream>
+{
+    Ptr<WaypointSource> source;         //!< where commands come from
+    std::vector<Ns2NodeCourse> courses; //!< indexed by trace node id
+    Time window;                        //!< scheduling horizon
+    Ns2TraceWaypoint next;              //!< first command not scheduled yet
+    bool hasNext{false};                //!< false once the trace is exhausted
+    uint64_t scheduled{0};              //!< commands handed to the courses
+    uint64_t ignored{0};                //!< commands of unmapped trace nodes
+};
+
+void
+Refill(Ptr<Stream> stream)
+{
+    Time limit = Simulator::Now() + stream->window;
+    uint64_t before = stream->scheduled;
+    while (stream->hasNext && Seconds(stream->next.time) < limit)
+    {
+        if (stream->next.nodeId < stream->courses.size())
+        {
+            stream->courses[stream->next.nodeId].Apply(stream->next);
+            ++stream->scheduled;
+        }
+        else
+        {
+            ++stream->ignored;
+        }
+        stream->hasNext = stream->source->Next(stream->next);
+    }
+    stream->source->ReleaseConsumed();
+    NS_LOG_DEBUG("Scheduled " << stream->scheduled - before << " commands until " << limit);
+    if (stream->hasNext)
+    {
+        Simulator::Schedule(stream->window, &Refill, stream);
+    }
+    else
+    {
+        NS_LOG_INFO("End of trace: " << stream->scheduled << " commands scheduled, "
+                                     << stream->ignored << " ignored");
+    }
+}
+
+bool
+IsBinaryTrace(const std::string& filename)
+{
+    static const std::string extension = ".ns2b";
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) ==
+               0;
+}
+
+} // namespace
+
+Ns2StreamingMobilityHelper::Ns2StreamingMobilityHelper(std::string filename)
+    : m_filename(filename),
+      m_window(Seconds(10))
+{
+}
+
+void
+Ns2StreamingMobilityHelper::SetWindow(Time window)
+{
+    NS_ABORT_MSG_UNLESS(window.IsStrictlyPositive(), "The scheduling window must be positive");
+    m_window = window;
+}
+
+void
+Ns2StreamingMobilityHelper::SetLazy(bool lazy)
+{
+    m_lazy = lazy;
+}
+
+void
+Ns2StreamingMobilityHelper::Install() const
+{
+    Install(NodeList::Begin(), NodeList::End());
+}
+
+void
+Ns2StreamingMobilityHelper::DoInstall(const std::vector<Ptr<Node>>& nodes) const
+{
+    Ptr<Stream> stream = Create<Stream>();
+    if (IsBinaryTrace(m_filename))
+    {
+        stream->source = Create<BinarySource>(m_filename);
+    }
+    else
+    {
+        stream->source = Create<TclSource>(m_filename);
+    }
+    stream->window = m_window;
+    stream->courses.resize(nodes.size());
+    for (uint32_t i = 0; i < nodes.size(); ++i)
+    {
+        stream->courses[i].Attach(nodes[i], m_lazy);
+    }
+
+    std::vector<Ns2TraceInitialPosition> initial;
+    stream->source->ReadInitialPositions(initial);
+    for (const auto& pos : initial)
+    {
+        if (pos.mask != 0 && pos.nodeId < nodes.size())
+        {
+            stream->courses[pos.nodeId].SetInitialPosition(pos);
+        }
+    }
+
+    stream->hasNext = stream->source->Next(stream->next);
+    Refill(stream);
+}
+
+} // namespace ns3
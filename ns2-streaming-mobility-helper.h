@@ -0,0 +1,91 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef NS2_STREAMING_MOBILITY_HELPER_H
+#define NS2_STREAMING_MOBILITY_HELPER_H
+
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Install an ns-2 mobility trace incrementally.
+ *
+ * Ns2MobilityHelper (and Ns2BinaryMobilityHelper) schedule the events of
+ * the whole trace before Simulator::Run, so the event queue holds every
+ * future waypoint of every node. This helper only schedules the commands
+ * due within the next window and refills the queue with a periodic event,
+ * so the number of pending mobility events, and the memory, stay flat no
+ * matter how long the trace is. The movements are the same as with
+ * Ns2MobilityHelper.
+ *
+ * Both the TCL text (".tcl") and the binary format (".ns2b", see
+ * mobility/ns2-tcltool) are accepted; both are memory-mapped and the pages
+ * already consumed are released. A TCL trace must be sorted by time and
+ * have its "$node_(i) set X_" initial positions before the first
+ * "$ns_ at" line; convert it to .ns2b otherwise.
+ */
+class Ns2StreamingMobilityHelper
+{
+  public:
+    /**
+     * \param filename path of the .tcl or .ns2b trace
+     */
+    Ns2StreamingMobilityHelper(std::string filename);
+
+    /**
+     * \param window how far ahead of the current time commands are
+     * scheduled; also the period of the refill event
+     */
+    void SetWindow(Time window);
+
+    /**
+     * \param lazy record the commands of the window in Ns2LazyMobilityModel
+     * instead of scheduling their events
+     */
+    void SetLazy(bool lazy);
+
+    /**
+     * Install the movements on the nodes of NodeList.
+     */
+    void Install() const;
+
+    /**
+     * \param begin an iterator to the first node
+     * \param end an iterator past the last node
+     */
+    template <typename T>
+    void Install(T begin, T end) const;
+
+  private:
+    /**
+     * \param nodes nodes indexed by trace node id
+     */
+    void DoInstall(const std::vector<Ptr<Node>>& nodes) const;
+
+    std::string m_filename; //!< path of the trace
+    Time m_window;          //!< scheduling window
+    bool m_lazy{false};     //!< drive Ns2LazyMobilityModel
+};
+
+template <typename T>
+void
+Ns2StreamingMobilityHelper::Install(T begin, T end) const
+{
+    std::vector<Ptr<Node>> nodes;
+    for (T i = begin; i != end; ++i)
+    {
+        nodes.push_back(*i);
+    }
+    DoInstall(nodes);
+}
+
+} // namespace ns3
+
+#endif /* NS2_STREAMING_MOBILITY_HELPER_H */
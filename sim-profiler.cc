@@ -0,0 +1,356 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sim-profiler.h"
+
+#include "ns3/abort.h"
+#include "ns3/event-impl.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/object-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/type-id.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <iomanip>
+#include <map>
+#include <typeinfo>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimProfiler");
+
+NS_OBJECT_ENSURE_REGISTERED(ProfilingScheduler);
+
+/// Category of an event type: the first rule whose pattern appears in the name.
+static const std::vector<std::pair<const char*, const char*>> CATEGORY_RULES = {
+    {"MobilityModel", "mobility"},
+    {"Ns2", "mobility"},
+    {"NrUeMac", "nr-ue-mac"},
+    {"NrSl", "nr-ue-mac"},
+    {"NrUePhy", "nr-ue-phy"},
+    {"NrSpectrumPhy", "nr-ue-phy"},
+    {"NrInterference", "nr-ue-phy"},
+    {"NrChAccessManager", "nr-ue-phy"},
+    {"SpectrumChannel", "spectrum-channel"},
+    {"NrGnb", "nr-gnb"},
+    {"Application", "application"},
+    {"OnOff", "application"},
+    {"PacketSink", "application"},
+    {"Socket", "network"},
+    {"Udp", "network"},
+    {"Ipv4", "network"},
+    {"Ipv6", "network"},
+    {"Icmpv6", "network"},
+    {"Epc", "network"},
+    {"PointToPoint", "network"},
+};
+
+static std::string
+Demangle(const char* name)
+{
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+    std::string result = (status == 0 && demangled) ? demangled : name;
+    std::free(demangled);
+    return result;
+}
+
+static std::string
+CategoryOf(const std::string& name)
+{
+    for (const auto& rule : CATEGORY_RULES)
+    {
+        if (name.find(rule.first) != std::string::npos)
+        {
+            return rule.second;
+        }
+    }
+    return "other";
+}
+
+/**
+ * \brief Event timing the event it wraps.
+ *
+ * Owns the reference to the wrapped event that the scheduler would own.
+ */
+class ProfiledEventImpl : public EventImpl
+{
+  public:
+    /**
+     * \param inner the wrapped event, whose reference is taken over
+     * \param index type of \p inner in SimProfiler
+     */
+    ProfiledEventImpl(EventImpl* inner, uint32_t index)
+        : m_inner(inner),
+          m_index(index)
+    {
+    }
+
+    ~ProfiledEventImpl() override
+    {
+        if (m_inner)
+        {
+            m_inner->Unref();
+        }
+    }
+
+    /// Give the reference to the wrapped event back.
+    void Release()
+    {
+        m_inner = nullptr;
+    }
+
+  protected:
+    void Notify() override
+    {
+        if (m_inner->IsCancelled())
+        {
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        m_inner->Invoke();
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        SimProfiler::Get().AddExecuted(m_index, wall.count());
+    }
+
+  private:
+    EventImpl* m_inner; //!< wrapped event
+    uint32_t m_index;   //!< type of the wrapped event
+};
+
+SimProfiler&
+SimProfiler::Get()
+{
+    static SimProfiler profiler;
+    return profiler;
+}
+
+void
+SimProfiler::Install(Time bin)
+{
+    SimProfiler& profiler = Get();
+    NS_ABORT_MSG_IF(profiler.m_enabled, "SimProfiler already installed");
+    profiler.m_enabled = true;
+    profiler.m_bin = bin;
+
+    TypeIdValue current;
+    GlobalValue::GetValueByName("SchedulerType", current);
+    ObjectFactory factory("ns3::ProfilingScheduler");
+    factory.Set("InnerSchedulerType", StringValue(current.Get().GetName()));
+    Simulator::SetScheduler(factory);
+}
+
+bool
+SimProfiler::IsEnabled()
+{
+    return Get().m_enabled;
+}
+
+uint32_t
+SimProfiler::TypeIndex(const std::type_info& type)
+{
+    auto it = m_types.find(type);
+    if (it != m_types.end())
+    {
+        return it->second;
+    }
+    std::string name = Demangle(type.name());
+    m_entries.push_back(Entry{name, CategoryOf(name), 0, 0, 0.0, true});
+    m_types.emplace(type, m_entries.size() - 1);
+    return m_entries.size() - 1;
+}
+
+uint32_t
+SimProfiler::NameIndex(const std::string& name, const std::string& category)
+{
+    auto it = m_names.find(name);
+    if (it != m_names.end())
+    {
+        return it->second;
+    }
+    m_entries.push_back(Entry{name, category, 0, 0, 0.0, false});
+    m_names.emplace(name, m_entries.size() - 1);
+    return m_entries.size() - 1;
+}
+
+void
+SimProfiler::AddScheduled(uint32_t index)
+{
+    ++m_entries[index].scheduled;
+}
+
+void
+SimProfiler::AddExecuted(uint32_t index, double wallSeconds)
+{
+    Entry& entry = m_entries[index];
+    ++entry.executed;
+    entry.wall += wallSeconds;
+
+    size_t bin = Simulator::Now().GetTimeStep() / m_bin.GetTimeStep();
+    if (bin >= m_bins.size())
+    {
+        m_bins.resize(bin + 1);
+    }
+    ++m_bins[bin].events;
+    m_bins[bin].wall += wallSeconds;
+}
+
+void
+SimProfiler::AddCall(uint32_t index, double wallSeconds)
+{
+    Entry& entry = m_entries[index];
+    ++entry.executed;
+    entry.wall += wallSeconds;
+}
+
+void
+SimProfiler::Report(std::ostream& os) const
+{
+    double eventWall = 0;
+    uint64_t events = 0;
+    std::map<std::string, Entry> categories;
+    for (const auto& entry : m_entries)
+    {
+        std::string key = entry.isEvent ? entry.category : entry.category + " (calls)";
+        Entry& category = categories[key];
+        category.scheduled += entry.scheduled;
+        category.executed += entry.executed;
+        category.wall += entry.wall;
+        if (entry.isEvent)
+        {
+            eventWall += entry.wall;
+            events += entry.executed;
+        }
+    }
+
+    os << std::fixed;
+    os << "Events executed: " << events << ", wall time in events: " << std::setprecision(3)
+       << eventWall << " s\n\n";
+    os << std::left << std::setw(24) << "category" << std::right << std::setw(14) << "scheduled"
+       << std::setw(14) << "executed" << std::setw(12) << "wall (s)" << std::setw(9) << "wall %"
+       << std::setw(12) << "ns/event" << "\n";
+    for (const auto& [name, category] : categories)
+    {
+        os << std::left << std::setw(24) << name << std::right << std::setw(14)
+           << category.scheduled << std::setw(14) << category.executed << std::setw(12)
+           << std::setprecision(3) << category.wall << std::setw(9) << std::setprecision(1)
+           << (eventWall > 0 ? 100 * category.wall / eventWall : 0.0) << std::setw(12)
+           << std::setprecision(0)
+           << (category.executed ? 1e9 * category.wall / category.executed : 0.0) << "\n";
+    }
+
+    std::vector<const Entry*> sorted;
+    for (const auto& entry : m_entries)
+    {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+        return a->wall > b->wall;
+    });
+    os << "\nMost expensive event types and calls\n";
+    for (size_t i = 0; i < std::min<size_t>(sorted.size(), 25); ++i)
+    {
+        const Entry& entry = *sorted[i];
+        os << std::setw(12) << std::setprecision(3) << entry.wall << " s " << std::setw(12)
+           << entry.executed << "  [" << entry.category << "] " << entry.name.substr(0, 160)
+           << "\n";
+    }
+
+    os << "\nSimulated time bins\n"
+       << std::setw(12) << "time (s)" << std::setw(14) << "events" << std::setw(12) << "wall (s)"
+       << std::setw(14) << "events/s" << "\n";
+    for (size_t i = 0; i < m_bins.size(); ++i)
+    {
+        const Bin& bin = m_bins[i];
+        os << std::setw(12) << std::setprecision(3) << m_bin.GetSeconds() * i << std::setw(14)
+           << bin.events << std::setw(12) << bin.wall << std::setw(14) << std::setprecision(0)
+           << (bin.wall > 0 ? bin.events / bin.wall : 0.0) << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+TypeId
+ProfilingScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::ProfilingScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<ProfilingScheduler>()
+            .AddAttribute("InnerSchedulerType",
+                          "TypeId of the scheduler holding the events",
+                          StringValue("ns3::MapScheduler"),
+                          MakeStringAccessor(&ProfilingScheduler::SetInnerSchedulerType),
+                          MakeStringChecker());
+    return tid;
+}
+
+ProfilingScheduler::ProfilingScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+ProfilingScheduler::~ProfilingScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+ProfilingScheduler::SetInnerSchedulerType(std::string type)
+{
+    NS_ABORT_MSG_IF(m_inner && !m_inner->IsEmpty(), "Inner scheduler set with queued events");
+    ObjectFactory factory(type);
+    m_inner = factory.Create<Scheduler>();
+}
+
+void
+ProfilingScheduler::Insert(const Scheduler::Event& ev)
+{
+    SimProfiler& profiler = SimProfiler::Get();
+    uint32_t index = profiler.TypeIndex(typeid(*ev.impl));
+    profiler.AddScheduled(index);
+    auto wrapper = new ProfiledEventImpl(ev.impl, index);
+    m_queued[ev.key.m_uid] = wrapper;
+    m_inner->Insert(Scheduler::Event{wrapper, ev.key});
+}
+
+bool
+ProfilingScheduler::IsEmpty() const
+{
+    return m_inner->IsEmpty();
+}
+
+Scheduler::Event
+ProfilingScheduler::PeekNext() const
+{
+    return m_inner->PeekNext();
+}
+
+Scheduler::Event
+ProfilingScheduler::RemoveNext()
+{
+    Scheduler::Event ev = m_inner->RemoveNext();
+    m_queued.erase(ev.key.m_uid);
+    return ev;
+}
+
+void
+ProfilingScheduler::Remove(const Scheduler::Event& ev)
+{
+    // The simulator cancels and unrefs ev.impl, the wrapped event, itself
+    auto it = m_queued.find(ev.key.m_uid);
+    NS_ASSERT(it != m_queued.end());
+    auto wrapper = static_cast<ProfiledEventImpl*>(it->second);
+    m_queued.erase(it);
+    m_inner->Remove(Scheduler::Event{wrapper, ev.key});
+    wrapper->Release();
+    wrapper->Unref();
+}
+
+} // namespace ns3
@@ -0,0 +1,148 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SIM_PROFILER_H
+#define SIM_PROFILER_H
+
+#include "ns3/nstime.h"
+#include "ns3/scheduler.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Event counts and wall clock of Simulator::Run, by event type.
+ *
+ * Once installed, every event goes through a ProfilingScheduler, which
+ * counts it when scheduled and times it when executed. Events are grouped
+ * by the type of their EventImpl, which names the method or function they
+ * call (e.g. NrUePhy::StartSlot), and every type is assigned to a category
+ * (mobility, nr-ue-phy, nr-ue-mac, application, ...). Code that does not
+ * run as an event, such as the stats sinks called from trace sources,
+ * reports its wall time with AddCall(); that time is also part of the
+ * event that fired the trace.
+ *
+ * Executed events and their wall time are also binned over simulated time,
+ * giving the events per second of every part of the run.
+ */
+class SimProfiler
+{
+  public:
+    /// \return the profiler
+    static SimProfiler& Get();
+
+    /**
+     * Put a ProfilingScheduler in front of the current scheduler type.
+     * \param bin width of the simulated time bins
+     */
+    static void Install(Time bin);
+
+    /// \return true once Install() was called
+    static bool IsEnabled();
+
+    /**
+     * \param type type of an EventImpl
+     * \return index of the type, registered on first use
+     */
+    uint32_t TypeIndex(const std::type_info& type);
+
+    /**
+     * \param name name of code timed by AddCall()
+     * \param category its category
+     * \return index of the name, registered on first use
+     */
+    uint32_t NameIndex(const std::string& name, const std::string& category);
+
+    /// \param index type scheduled once more
+    void AddScheduled(uint32_t index);
+
+    /**
+     * \param index type of the executed event
+     * \param wallSeconds wall time of the event
+     */
+    void AddExecuted(uint32_t index, double wallSeconds);
+
+    /**
+     * \param index name of the code
+     * \param wallSeconds wall time of the call
+     */
+    void AddCall(uint32_t index, double wallSeconds);
+
+    /**
+     * Write the categories, the most expensive types and the time bins.
+     * \param os output stream
+     */
+    void Report(std::ostream& os) const;
+
+  private:
+    SimProfiler() = default;
+
+    /// Counters of one event type or named code.
+    struct Entry
+    {
+        std::string name;      //!< demangled type or name
+        std::string category;  //!< category of the entry
+        uint64_t scheduled{0}; //!< events scheduled
+        uint64_t executed{0};  //!< events executed, or calls
+        double wall{0};        //!< wall time, in seconds
+        bool isEvent{true};    //!< false for AddCall() entries
+    };
+
+    /// Counters of one simulated time bin.
+    struct Bin
+    {
+        uint64_t events{0}; //!< events executed
+        double wall{0};     //!< wall time of the events
+    };
+
+    bool m_enabled{false};                                 //!< Install() was called
+    Time m_bin;                                            //!< width of the time bins
+    std::vector<Entry> m_entries;                          //!< types and names
+    std::unordered_map<std::type_index, uint32_t> m_types; //!< index of every type
+    std::unordered_map<std::string, uint32_t> m_names;     //!< index of every name
+    std::vector<Bin> m_bins;                               //!< simulated time bins
+};
+
+/**
+ * \brief Scheduler counting and timing every event for SimProfiler.
+ *
+ * Wraps the events in a timing EventImpl and forwards them to an inner
+ * scheduler, of type InnerSchedulerType.
+ */
+class ProfilingScheduler : public Scheduler
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    ProfilingScheduler();
+    ~ProfilingScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    /// \param type type id of the inner scheduler
+    void SetInnerSchedulerType(std::string type);
+
+    Ptr<Scheduler> m_inner;                            //!< the real scheduler
+    std::unordered_map<uint32_t, EventImpl*> m_queued; //!< wrapper of every queued uid
+};
+
+} // namespace ns3
+
+#endif /* SIM_PROFILER_H */
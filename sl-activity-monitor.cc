@@ -0,0 +1,109 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-activity-monitor.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/nr-ue-net-device.h"
+#include "ns3/object-vector.h"
+#include "ns3/simulator.h"
+
+#include <fstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlActivityMonitor");
+
+void
+SlActivityMonitor::Connect(const NetDeviceContainer& devices)
+{
+    for (auto it = devices.Begin(); it != devices.End(); ++it)
+    {
+        Ptr<NrUeNetDevice> device = DynamicCast<NrUeNetDevice>(*it);
+        if (!device)
+        {
+            continue;
+        }
+        m_ues.push_back(std::make_unique<Ue>(Ue{device->GetNode()->GetId()}));
+        Ue* ue = m_ues.back().get();
+        ue->numerology = device->GetPhy(0)->GetNumerology();
+        m_slot = device->GetPhy(0)->GetSlotPeriod();
+        for (uint32_t cc = 0; cc < device->GetCcMapSize(); ++cc)
+        {
+            device->GetMac(cc)->TraceConnectWithoutContext(
+                "SlPsschScheduling",
+                MakeBoundCallback(&SlActivityMonitor::Sent, ue));
+            ObjectVectorValue spectrumPhys;
+            device->GetPhy(cc)->GetAttribute("NrSpectrumPhyList", spectrumPhys);
+            for (auto phy = spectrumPhys.Begin(); phy != spectrumPhys.End(); ++phy)
+            {
+                phy->second->TraceConnectWithoutContext(
+                    "RxPsschTraceUe",
+                    MakeBoundCallback(&SlActivityMonitor::Received, ue));
+            }
+        }
+    }
+}
+
+void
+SlActivityMonitor::Sent(Ue* ue, const SlPsschUeMacStatParameters params)
+{
+    uint64_t slot =
+        SfnSf(params.frameNum, params.subframeNum, params.slotNum, ue->numerology).Normalize();
+    if (slot != ue->lastTx)
+    {
+        ue->lastTx = slot;
+        ++ue->txSlots;
+    }
+}
+
+void
+SlActivityMonitor::Received(Ue* ue, const SlRxDataPacketTraceParams params)
+{
+    uint64_t slot =
+        SfnSf(params.m_frameNum, params.m_subframeNum, params.m_slotNum, ue->numerology)
+            .Normalize();
+    if (slot != ue->lastRx)
+    {
+        ue->lastRx = slot;
+        ++ue->rxSlots;
+    }
+}
+
+uint64_t
+SlActivityMonitor::GetSlots() const
+{
+    return m_slot.IsStrictlyPositive() ? Simulator::Now().GetTimeStep() / m_slot.GetTimeStep()
+                                       : 0;
+}
+
+uint64_t
+SlActivityMonitor::GetSlotsWithoutPssch() const
+{
+    uint64_t slots = GetSlots();
+    uint64_t without = 0;
+    for (const auto& ue : m_ues)
+    {
+        uint64_t busy = ue->txSlots + ue->rxSlots;
+        without += busy < slots ? slots - busy : 0;
+    }
+    return without;
+}
+
+void
+SlActivityMonitor::Write(const std::string& prefix) const
+{
+    uint64_t slots = GetSlots();
+    std::ofstream out(prefix + "-sl-activity.csv");
+    out << "node,slots,txSlots,rxSlots,slotsWithoutPssch\n";
+    for (const auto& ue : m_ues)
+    {
+        uint64_t busy = ue->txSlots + ue->rxSlots;
+        out << ue->node << "," << slots << "," << ue->txSlots << "," << ue->rxSlots << ","
+            << (busy < slots ? slots - busy : 0) << "\n";
+    }
+}
+
+} // namespace ns3
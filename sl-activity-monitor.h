@@ -0,0 +1,87 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_ACTIVITY_MONITOR_H
+#define SL_ACTIVITY_MONITOR_H
+
+#include "ns3/net-device-container.h"
+#include "ns3/nr-sl-phy-mac-common.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Sidelink slots in which every UE sends or receives a PSSCH.
+ *
+ * Counts, per UE, the slots in which it sends a PSSCH (SlPsschScheduling of
+ * its NrUeMac) or receives one (RxPsschTraceUe of its NrSpectrumPhy), and
+ * the elapsed slots without either. The latter only bound the slots an
+ * activity-driven PHY and MAC could skip: the PSCCH decoding and the
+ * sensing of those slots are not traced here, and nothing is skipped.
+ */
+class SlActivityMonitor
+{
+  public:
+    SlActivityMonitor() = default;
+
+    SlActivityMonitor(const SlActivityMonitor&) = delete;
+    SlActivityMonitor& operator=(const SlActivityMonitor&) = delete;
+
+    /**
+     * Count the slots of every NrUeNetDevice of \p devices.
+     * \param devices the UE devices
+     */
+    void Connect(const NetDeviceContainer& devices);
+
+    /// \return slots elapsed since the start
+    uint64_t GetSlots() const;
+
+    /// \return slots of the connected UEs with no PSSCH sent or received
+    uint64_t GetSlotsWithoutPssch() const;
+
+    /**
+     * Write <prefix>-sl-activity.csv: per UE, the slots it sent and
+     * received a PSSCH in, and the slots without either.
+     * \param prefix output path without suffix
+     */
+    void Write(const std::string& prefix) const;
+
+  private:
+    /// Counters of one UE.
+    struct Ue
+    {
+        uint32_t node;                 //!< node id
+        uint8_t numerology{0};         //!< numerology of the sidelink BWP
+        uint64_t txSlots{0};           //!< slots with a PSSCH sent
+        uint64_t rxSlots{0};           //!< slots with a PSSCH received
+        uint64_t lastTx{~uint64_t(0)}; //!< last slot counted in txSlots
+        uint64_t lastRx{~uint64_t(0)}; //!< last slot counted in rxSlots
+    };
+
+    /**
+     * SlPsschScheduling sink.
+     * \param ue the sending UE
+     * \param params the transmission
+     */
+    static void Sent(Ue* ue, const SlPsschUeMacStatParameters params);
+
+    /**
+     * RxPsschTraceUe sink.
+     * \param ue the receiving UE
+     * \param params the reception
+     */
+    static void Received(Ue* ue, const SlRxDataPacketTraceParams params);
+
+    Time m_slot;                            //!< slot duration
+    std::vector<std::unique_ptr<Ue>> m_ues; //!< connected UEs
+};
+
+} // namespace ns3
+
+#endif /* SL_ACTIVITY_MONITOR_H */
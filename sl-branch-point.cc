@@ -0,0 +1,128 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-branch-point.h"
+
+#include "ns3/abort.h"
+#include "ns3/config.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlBranchPoint");
+
+std::vector<SlBranchPoint::Branch>
+SlBranchPoint::ReadBranches(const std::string& filename)
+{
+    std::ifstream file(filename);
+    NS_ABORT_MSG_UNLESS(file, "Cannot read the branches of " << filename);
+    std::vector<Branch> branches;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream words(line);
+        Branch branch;
+        if (!(words >> branch.tag) || branch.tag[0] == '#')
+        {
+            continue;
+        }
+        std::string setting;
+        while (words >> setting)
+        {
+            size_t equal = setting.find('=');
+            NS_ABORT_MSG_IF(equal == std::string::npos,
+                            "Branch " << branch.tag << ": " << setting << " is not path=value");
+            branch.settings.emplace_back(setting.substr(0, equal), setting.substr(equal + 1));
+        }
+        branches.push_back(branch);
+    }
+    return branches;
+}
+
+SlBranchPoint::SlBranchPoint(Time at,
+                             std::vector<Branch> branches,
+                             uint32_t jobs,
+                             std::function<void(const Branch&)> onBranch)
+    : m_branches(std::move(branches)),
+      m_jobs(jobs ? jobs : std::max(1u, std::thread::hardware_concurrency())),
+      m_onBranch(std::move(onBranch))
+{
+    NS_ABORT_MSG_IF(m_branches.empty(), "SlBranchPoint without branches");
+    Simulator::Schedule(at, &SlBranchPoint::Fork, this);
+}
+
+bool
+SlBranchPoint::IsParent() const
+{
+    return m_parent;
+}
+
+uint32_t
+SlBranchPoint::GetFailures() const
+{
+    return m_failures;
+}
+
+void
+SlBranchPoint::Fork()
+{
+    // Buffered output would be written again by every child
+    std::cout.flush();
+    std::fflush(stdout);
+    std::fflush(stderr);
+
+    std::map<pid_t, size_t> running;
+    size_t next = 0;
+    while (next < m_branches.size() || !running.empty())
+    {
+        if (next < m_branches.size() && running.size() < m_jobs)
+        {
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "Cannot fork branch " << m_branches[next].tag);
+            if (pid == 0)
+            {
+                const Branch& branch = m_branches[next];
+                for (const auto& [path, value] : branch.settings)
+                {
+                    Config::Set(path, StringValue(value));
+                }
+                m_onBranch(branch);
+                return;
+            }
+            std::cout << "Branch " << m_branches[next].tag << " started, pid " << pid
+                      << std::endl;
+            running[pid] = next++;
+            continue;
+        }
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        NS_ABORT_MSG_IF(pid < 0, "waitpid failed");
+        auto it = running.find(pid);
+        if (it == running.end())
+        {
+            continue;
+        }
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        m_failures += ok ? 0 : 1;
+        std::cout << "Branch " << m_branches[it->second].tag << (ok ? " done" : " failed")
+                  << std::endl;
+        running.erase(it);
+    }
+    m_parent = true;
+    Simulator::Stop();
+}
+
+} // namespace ns3
@@ -0,0 +1,83 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_BRANCH_POINT_H
+#define SL_BRANCH_POINT_H
+
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Runs several variants of a simulation from one shared warm-up.
+ *
+ * At the branch time the process forks one child per branch. Every child
+ * continues from the exact state of the parent (node positions, pending
+ * mobility waypoints, MAC sensing and reservations, RNG stream positions,
+ * pending events), applies the attribute settings of its branch with
+ * Config::Set, runs the OnBranch callback (which opens its own outputs) and
+ * finishes the simulation. The parent keeps the warm-up state, forks at
+ * most \p jobs children at a time, and stops once they all exited.
+ *
+ * The snapshot lives in the memory of the parent process: ns-3 events are
+ * closures over C++ objects, which cannot be serialized to disk.
+ */
+class SlBranchPoint
+{
+  public:
+    /// One variant of the simulation after the branch time.
+    struct Branch
+    {
+        std::string tag;                                           //!< appended to the simTag
+        std::vector<std::pair<std::string, std::string>> settings; //!< Config path, value
+    };
+
+    /**
+     * Read the branches of a file, one per line: a tag followed by
+     * path=value settings, all separated by blanks, e.g.
+     *   rate32 /NodeList/0/ApplicationList/0/$ns3::OnOffApplication/DataRate=32kb/s
+     * Empty lines and lines starting with # are skipped.
+     * \param filename the file
+     * \return the branches, aborts on unreadable files
+     */
+    static std::vector<Branch> ReadBranches(const std::string& filename);
+
+    /**
+     * Schedule the branch.
+     * \param at simulation time of the branch
+     * \param branches variants to run
+     * \param jobs children running at a time, 0 for one per CPU
+     * \param onBranch called in every child after the settings are applied
+     */
+    SlBranchPoint(Time at,
+                  std::vector<Branch> branches,
+                  uint32_t jobs,
+                  std::function<void(const Branch&)> onBranch);
+
+    /// \return true in the process that forked the branches, once they ran
+    bool IsParent() const;
+
+    /// \return branches whose child failed, in the parent
+    uint32_t GetFailures() const;
+
+  private:
+    /// Fork the branches; returns in the children and in the parent once done.
+    void Fork();
+
+    std::vector<Branch> m_branches;                //!< variants to run
+    uint32_t m_jobs;                               //!< children at a time
+    std::function<void(const Branch&)> m_onBranch; //!< called in every child
+    bool m_parent{false};                          //!< this process forked
+    uint32_t m_failures{0};                        //!< failed children
+};
+
+} // namespace ns3
+
+#endif /* SL_BRANCH_POINT_H */
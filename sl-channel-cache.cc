@@ -0,0 +1,184 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-channel-cache.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+
+#include <cmath>
+#include <utility>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlChannelCache");
+
+NS_OBJECT_ENSURE_REGISTERED(SlCachedChannelModel);
+NS_OBJECT_ENSURE_REGISTERED(SlCachedChannelConditionModel);
+
+/// \return the key of the pair of \p a and \p b, the same in both directions
+static uint64_t
+PairKey(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b)
+{
+    return MatrixBasedChannelModel::GetKey(a->GetObject<Node>()->GetId(),
+                                           b->GetObject<Node>()->GetId());
+}
+
+SlGeometryCell
+SlGeometryCell::Of(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, double size)
+{
+    if (a->GetObject<Node>()->GetId() > b->GetObject<Node>()->GetId())
+    {
+        std::swap(a, b);
+    }
+    Vector relative = b->GetPosition() - a->GetPosition();
+    SlGeometryCell cell;
+    cell.x = static_cast<int64_t>(std::floor(relative.x / size));
+    cell.y = static_cast<int64_t>(std::floor(relative.y / size));
+    cell.z = static_cast<int64_t>(std::floor(relative.z / size));
+    return cell;
+}
+
+TypeId
+SlCachedChannelModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlCachedChannelModel")
+            .SetParent<ThreeGppChannelModel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<SlCachedChannelModel>()
+            .AddAttribute("CellSize",
+                          "Edge, in meters, of the cells of the relative position of a pair "
+                          "inside which its channel matrix is reused",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&SlCachedChannelModel::m_cellSize),
+                          MakeDoubleChecker<double>(0.001));
+    return tid;
+}
+
+SlCachedChannelModel::SlCachedChannelModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlCachedChannelModel::~SlCachedChannelModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Ptr<const MatrixBasedChannelModel::ChannelMatrix>
+SlCachedChannelModel::GetChannel(Ptr<const MobilityModel> aMob,
+                                 Ptr<const MobilityModel> bMob,
+                                 Ptr<const PhasedArrayModel> aAntenna,
+                                 Ptr<const PhasedArrayModel> bAntenna)
+{
+    uint64_t key = PairKey(aMob, bMob);
+    SlGeometryCell cell = SlGeometryCell::Of(aMob, bMob, m_cellSize);
+    auto it = m_cache.find(key);
+    if (it != m_cache.end() && it->second.cell == cell)
+    {
+        ++m_hits;
+        return it->second.matrix;
+    }
+    ++m_misses;
+    Ptr<const ChannelMatrix> matrix =
+        ThreeGppChannelModel::GetChannel(aMob, bMob, aAntenna, bAntenna);
+    m_cache[key] = Entry{cell, matrix};
+    return matrix;
+}
+
+uint64_t
+SlCachedChannelModel::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+SlCachedChannelModel::GetMisses() const
+{
+    return m_misses;
+}
+
+TypeId
+SlCachedChannelConditionModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlCachedChannelConditionModel")
+            .SetParent<ChannelConditionModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<SlCachedChannelConditionModel>()
+            .AddAttribute("Inner",
+                          "Channel condition model drawing the conditions",
+                          PointerValue(),
+                          MakePointerAccessor(&SlCachedChannelConditionModel::m_inner),
+                          MakePointerChecker<ChannelConditionModel>())
+            .AddAttribute("CellSize",
+                          "Edge, in meters, of the cells of the relative position of a pair "
+                          "inside which its condition is reused",
+                          DoubleValue(1.0),
+                          MakeDoubleAccessor(&SlCachedChannelConditionModel::m_cellSize),
+                          MakeDoubleChecker<double>(0.001));
+    return tid;
+}
+
+SlCachedChannelConditionModel::SlCachedChannelConditionModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlCachedChannelConditionModel::~SlCachedChannelConditionModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SlCachedChannelConditionModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_cache.clear();
+    m_inner = nullptr;
+    ChannelConditionModel::DoDispose();
+}
+
+Ptr<ChannelCondition>
+SlCachedChannelConditionModel::GetChannelCondition(Ptr<const MobilityModel> a,
+                                                   Ptr<const MobilityModel> b) const
+{
+    NS_ASSERT_MSG(m_inner, "SlCachedChannelConditionModel without an Inner model");
+    uint64_t key = PairKey(a, b);
+    SlGeometryCell cell = SlGeometryCell::Of(a, b, m_cellSize);
+    auto it = m_cache.find(key);
+    if (it != m_cache.end() && it->second.cell == cell)
+    {
+        ++m_hits;
+        return it->second.condition;
+    }
+    ++m_misses;
+    Ptr<ChannelCondition> condition = m_inner->GetChannelCondition(a, b);
+    m_cache[key] = Entry{cell, condition};
+    return condition;
+}
+
+int64_t
+SlCachedChannelConditionModel::AssignStreams(int64_t stream)
+{
+    return m_inner ? m_inner->AssignStreams(stream) : 0;
+}
+
+uint64_t
+SlCachedChannelConditionModel::GetHits() const
+{
+    return m_hits;
+}
+
+uint64_t
+SlCachedChannelConditionModel::GetMisses() const
+{
+    return m_misses;
+}
+
+} // namespace ns3
@@ -0,0 +1,147 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_CHANNEL_CACHE_H
+#define SL_CHANNEL_CACHE_H
+
+#include "ns3/channel-condition-model.h"
+#include "ns3/three-gpp-channel-model.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+namespace ns3
+{
+
+/**
+ * \brief Relative position of a pair of nodes, quantized to a cubic cell.
+ *
+ * The position is taken from the node of lower id to the node of higher id,
+ * so that both directions of a link have the same cell.
+ */
+struct SlGeometryCell
+{
+    int64_t x{0}; //!< cell along x
+    int64_t y{0}; //!< cell along y
+    int64_t z{0}; //!< cell along z
+
+    /**
+     * \param a mobility of one node
+     * \param b mobility of the other node
+     * \param size edge of the cell, in meters
+     * \return the cell of the relative position of the pair
+     */
+    static SlGeometryCell Of(Ptr<const MobilityModel> a, Ptr<const MobilityModel> b, double size);
+
+    /// \return true if both cells are the same
+    bool operator==(const SlGeometryCell& other) const
+    {
+        return x == other.x && y == other.y && z == other.z;
+    }
+};
+
+/**
+ * \brief ThreeGppChannelModel reusing a channel matrix while the geometry of
+ * the pair stays in the same cell.
+ *
+ * The matrix of a pair is regenerated by the TR 38.901 procedure of the
+ * base class only when the relative position of the pair leaves the
+ * SlGeometryCell it was generated in; otherwise the matrix of the previous
+ * call is returned without going through the base class. Since the
+ * matrices returned for the pair do not change, the long term component of
+ * ThreeGppSpectrumPropagationLossModel is reused as well.
+ *
+ * The base class must regenerate when asked to: its UpdatePeriod has to be
+ * non-zero and shorter than the time between two calls (1 ns works).
+ */
+class SlCachedChannelModel : public ThreeGppChannelModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlCachedChannelModel();
+    ~SlCachedChannelModel() override;
+
+    // Inherited
+    Ptr<const ChannelMatrix> GetChannel(Ptr<const MobilityModel> aMob,
+                                        Ptr<const MobilityModel> bMob,
+                                        Ptr<const PhasedArrayModel> aAntenna,
+                                        Ptr<const PhasedArrayModel> bAntenna) override;
+
+    /// \return calls answered from the cache
+    uint64_t GetHits() const;
+
+    /// \return calls that generated a matrix
+    uint64_t GetMisses() const;
+
+  private:
+    /// Matrix of a pair and the cell it was generated in.
+    struct Entry
+    {
+        SlGeometryCell cell;             //!< geometry of the generation
+        Ptr<const ChannelMatrix> matrix; //!< the matrix
+    };
+
+    double m_cellSize;                           //!< edge of the cells, in meters
+    std::unordered_map<uint64_t, Entry> m_cache; //!< entry of every pair
+    uint64_t m_hits{0};                          //!< calls answered from the cache
+    uint64_t m_misses{0};                        //!< calls that generated a matrix
+};
+
+/**
+ * \brief Channel condition model reusing the condition of a pair while its
+ * geometry stays in the same cell.
+ *
+ * Wraps the condition model of the scenario (Inner), which must draw a new
+ * condition when asked to (UpdatePeriod non-zero, 1 ns works). Both the
+ * channel model and the pathloss model of a band query the condition, so
+ * both must be given this model for them to agree.
+ */
+class SlCachedChannelConditionModel : public ChannelConditionModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlCachedChannelConditionModel();
+    ~SlCachedChannelConditionModel() override;
+
+    // Inherited
+    Ptr<ChannelCondition> GetChannelCondition(Ptr<const MobilityModel> a,
+                                              Ptr<const MobilityModel> b) const override;
+    int64_t AssignStreams(int64_t stream) override;
+
+    /// \return calls answered from the cache
+    uint64_t GetHits() const;
+
+    /// \return calls that drew a condition
+    uint64_t GetMisses() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Condition of a pair and the cell it was drawn in.
+    struct Entry
+    {
+        SlGeometryCell cell;             //!< geometry of the draw
+        Ptr<ChannelCondition> condition; //!< the condition
+    };
+
+    Ptr<ChannelConditionModel> m_inner;                  //!< model drawing the conditions
+    double m_cellSize;                                   //!< edge of the cells, in meters
+    mutable std::unordered_map<uint64_t, Entry> m_cache; //!< entry of every pair
+    mutable uint64_t m_hits{0};                          //!< calls answered from the cache
+    mutable uint64_t m_misses{0};                        //!< calls that drew a condition
+};
+
+} // namespace ns3
+
+#endif /* SL_CHANNEL_CACHE_H */
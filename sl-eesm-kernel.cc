@@ -0,0 +1,243 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-eesm-kernel.h"
+
+#include "ns3/abort.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SL_EESM_X86 1
+#include <immintrin.h>
+#else
+#define SL_EESM_X86 0
+#endif
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Taylor coefficients 1/k! of exp(r), k = 12 down to 0.
+constexpr double EXP_POLY[] = {1.0 / 479001600, 1.0 / 39916800, 1.0 / 3628800, 1.0 / 362880,
+                               1.0 / 40320,     1.0 / 5040,     1.0 / 720,     1.0 / 120,
+                               1.0 / 24,        1.0 / 6,        1.0 / 2,       1.0,
+                               1.0};
+constexpr double LOG2E = 1.4426950408889634;
+constexpr double LN2_HI = 6.93147180369123816490e-01; // upper bits of ln(2)
+constexpr double LN2_LO = 1.90821492927058770002e-10; // ln(2) - LN2_HI
+constexpr double EXP_MIN = -708.0;                      // 2^n stays a normal double
+
+/// Gather the SINR of the allocation and return its minimum.
+double
+Gather(const double* sinr, const int* map, std::size_t n, std::vector<double>& out)
+{
+    out.resize(n);
+    double minimum = sinr[map[0]];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        out[i] = sinr[map[i]];
+        minimum = std::min(minimum, out[i]);
+    }
+    return minimum;
+}
+
+double
+SumScalar(const double* x, std::size_t begin, std::size_t n, double offset, double scale)
+{
+    double sum = 0;
+    for (std::size_t i = begin; i < n; ++i)
+    {
+        sum += std::exp((x[i] - offset) * scale);
+    }
+    return sum;
+}
+
+#if SL_EESM_X86
+
+__attribute__((target("avx2,fma"))) __m256d
+Exp4(__m256d x)
+{
+    x = _mm256_max_pd(x, _mm256_set1_pd(EXP_MIN));
+    __m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(LOG2E)),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(LN2_HI), x);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(LN2_LO), r);
+    __m256d p = _mm256_set1_pd(EXP_POLY[0]);
+    for (std::size_t k = 1; k < sizeof(EXP_POLY) / sizeof(EXP_POLY[0]); ++k)
+    {
+        p = _mm256_fmadd_pd(p, r, _mm256_set1_pd(EXP_POLY[k]));
+    }
+    // 2^n, built in the exponent field
+    __m128i n32 = _mm256_cvtpd_epi32(n);
+    __m256i bits = _mm256_slli_epi64(
+        _mm256_add_epi64(_mm256_cvtepi32_epi64(n32), _mm256_set1_epi64x(1023)),
+        52);
+    return _mm256_mul_pd(p, _mm256_castsi256_pd(bits));
+}
+
+__attribute__((target("avx2,fma"))) double
+SumAvx2(const double* x, std::size_t n, double offset, double scale)
+{
+    __m256d acc = _mm256_setzero_pd();
+    __m256d vOffset = _mm256_set1_pd(offset);
+    __m256d vScale = _mm256_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256d v = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(x + i), vOffset), vScale);
+        acc = _mm256_add_pd(acc, Exp4(v));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + SumScalar(x, i, n, offset, scale);
+}
+
+// GCC 12 warns about the _mm512_undefined_pd() of its own intrinsics
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+__attribute__((target("avx512f"))) __m512d
+Exp8(__m512d x)
+{
+    x = _mm512_max_pd(x, _mm512_set1_pd(EXP_MIN));
+    __m512d n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(LOG2E)),
+                                     _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m512d r = _mm512_fnmadd_pd(n, _mm512_set1_pd(LN2_HI), x);
+    r = _mm512_fnmadd_pd(n, _mm512_set1_pd(LN2_LO), r);
+    __m512d p = _mm512_set1_pd(EXP_POLY[0]);
+    for (std::size_t k = 1; k < sizeof(EXP_POLY) / sizeof(EXP_POLY[0]); ++k)
+    {
+        p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_POLY[k]));
+    }
+    return _mm512_scalef_pd(p, n);
+}
+
+__attribute__((target("avx512f"))) double
+SumAvx512(const double* x, std::size_t n, double offset, double scale)
+{
+    __m512d acc = _mm512_setzero_pd();
+    __m512d vOffset = _mm512_set1_pd(offset);
+    __m512d vScale = _mm512_set1_pd(scale);
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m512d v = _mm512_mul_pd(_mm512_sub_pd(_mm512_loadu_pd(x + i), vOffset), vScale);
+        acc = _mm512_add_pd(acc, Exp8(v));
+    }
+    alignas(64) double lanes[8];
+    _mm512_store_pd(lanes, acc);
+    double sum = 0;
+    for (double lane : lanes)
+    {
+        sum += lane;
+    }
+    return sum + SumScalar(x, i, n, offset, scale);
+}
+
+#pragma GCC diagnostic pop
+
+#endif /* SL_EESM_X86 */
+
+} // namespace
+
+SlEesmKernel::Isa
+SlEesmKernel::Parse(const std::string& name)
+{
+    Isa isa = SCALAR;
+    if (name == "auto")
+    {
+        return GetBest();
+    }
+    else if (name == "avx2")
+    {
+        isa = AVX2;
+    }
+    else if (name == "avx512")
+    {
+        isa = AVX512;
+    }
+    else if (name != "scalar")
+    {
+        NS_ABORT_MSG("Unknown EESM kernel " << name << ", use auto, scalar, avx2 or avx512");
+    }
+    NS_ABORT_MSG_UNLESS(IsSupported(isa), "The CPU does not support the " << name << " kernel");
+    return isa;
+}
+
+std::string
+SlEesmKernel::GetName(Isa isa)
+{
+    switch (isa)
+    {
+    case AVX2:
+        return "avx2";
+    case AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+bool
+SlEesmKernel::IsSupported(Isa isa)
+{
+#if SL_EESM_X86
+    switch (isa)
+    {
+    case AVX2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case AVX512:
+        return __builtin_cpu_supports("avx512f");
+    default:
+        return true;
+    }
+#else
+    return isa == SCALAR;
+#endif
+}
+
+SlEesmKernel::Isa
+SlEesmKernel::GetBest()
+{
+    if (IsSupported(AVX512))
+    {
+        return AVX512;
+    }
+    return IsSupported(AVX2) ? AVX2 : SCALAR;
+}
+
+double
+SlEesmKernel::EffectiveSinr(Isa isa,
+                            const double* sinr,
+                            const int* map,
+                            std::size_t n,
+                            double beta)
+{
+    NS_ABORT_MSG_IF(n == 0, "Number of allocated RBs cannot be 0");
+    thread_local std::vector<double> gathered;
+    double minimum = Gather(sinr, map, n, gathered);
+    double scale = -1.0 / beta;
+    double sum;
+    switch (isa)
+    {
+#if SL_EESM_X86
+    case AVX2:
+        sum = SumAvx2(gathered.data(), n, minimum, scale);
+        break;
+    case AVX512:
+        sum = SumAvx512(gathered.data(), n, minimum, scale);
+        break;
+#endif
+    default:
+        sum = SumScalar(gathered.data(), 0, n, minimum, scale);
+    }
+    return minimum - beta * std::log(sum / n);
+}
+
+} // namespace ns3
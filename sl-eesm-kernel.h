@@ -0,0 +1,70 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_EESM_KERNEL_H
+#define SL_EESM_KERNEL_H
+
+#include <cstddef>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief Vectorized EESM effective SINR.
+ *
+ * Computes SINR_eff = -beta * ln(1/N * sum_i exp(-sinr_i / beta)) over the
+ * RBs of an allocation. The sum is taken relative to the smallest SINR,
+ * m - beta * ln(1/N * sum_i exp(-(sinr_i - m) / beta)), which is the same
+ * value without the underflow of exp() at high SINR.
+ *
+ * The exponentials are computed 4 (AVX2) or 8 (AVX-512) at a time with a
+ * Cody-Waite reduction and a degree 12 polynomial, accurate to a few ulps;
+ * the scalar kernel uses std::exp. The instruction sets are detected at run
+ * time, so the binary does not need to be built with -mavx2.
+ */
+class SlEesmKernel
+{
+  public:
+    /// Implementations of the kernel.
+    enum Isa
+    {
+        SCALAR,
+        AVX2,
+        AVX512,
+    };
+
+    /**
+     * \param name "auto", "scalar", "avx2" or "avx512"
+     * \return the implementation, "auto" being the best supported one;
+     *         aborts on unknown names and unsupported instruction sets
+     */
+    static Isa Parse(const std::string& name);
+
+    /// \return the name of \p isa
+    static std::string GetName(Isa isa);
+
+    /// \return true if the CPU runs \p isa
+    static bool IsSupported(Isa isa);
+
+    /// \return the best implementation supported by the CPU
+    static Isa GetBest();
+
+    /**
+     * \param isa implementation to use, must be supported
+     * \param sinr linear SINR of every RB of the band
+     * \param map RBs of the allocation, indices into \p sinr
+     * \param n number of RBs of the allocation, > 0
+     * \param beta EESM beta of the MCS
+     * \return the effective SINR, linear
+     */
+    static double EffectiveSinr(Isa isa,
+                                const double* sinr,
+                                const int* map,
+                                std::size_t n,
+                                double beta);
+};
+
+} // namespace ns3
+
+#endif /* SL_EESM_KERNEL_H */
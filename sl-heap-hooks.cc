@@ -0,0 +1,105 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+/*
+ * Replacement of the global operator new and delete for the whole
+ * executable, compiled in when SL_HEAP_HOOKS is 1 (sl-heap-hooks.h): every
+ * allocation of this program and of the ns-3 libraries it loads then goes
+ * through here, whatever the options. They call malloc and free as the
+ * default ones do, and count the allocations of each thread for
+ * SlHeapCounter. Inside an SlSpectrumArena::Scope, once the arena is
+ * enabled (spectrumArena), small requests are served by the arena
+ * instead, and delete hands its blocks back to it.
+ */
+#include "sl-heap-hooks.h"
+
+#include "sl-spectrum-arena.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+/// Calls of the global operator new of this thread that reached malloc.
+thread_local uint64_t t_allocations = 0;
+
+} // namespace
+
+#if SL_HEAP_HOOKS
+
+void*
+operator new(std::size_t size)
+{
+    if (void* p = ns3::SlSpectrumArena::Allocate(size))
+    {
+        return p;
+    }
+    ++t_allocations;
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    if (!ns3::SlSpectrumArena::Free(p))
+    {
+        std::free(p);
+    }
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    if (!ns3::SlSpectrumArena::Free(p))
+    {
+        std::free(p);
+    }
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    if (!ns3::SlSpectrumArena::Free(p))
+    {
+        std::free(p);
+    }
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    if (!ns3::SlSpectrumArena::Free(p))
+    {
+        std::free(p);
+    }
+}
+
+#endif /* SL_HEAP_HOOKS */
+
+namespace ns3
+{
+
+bool
+SlHeapCounter::IsEnabled()
+{
+    return SL_HEAP_HOOKS;
+}
+
+uint64_t
+SlHeapCounter::GetAllocations()
+{
+    return t_allocations;
+}
+
+} // namespace ns3
@@ -0,0 +1,48 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_HEAP_HOOKS_H
+#define SL_HEAP_HOOKS_H
+
+#include <cstdint>
+
+/*
+ * The replacement of the global operator new and delete (sl-heap-hooks.cc)
+ * applies to the whole executable, so it is only compiled in as a
+ * diagnostic: in the ns-3 debug profile, as EXP01_DIAGNOSTICS, and out of
+ * the release/optimized "production" profiles. Build with
+ * -DSL_HEAP_HOOKS=0 or 1 to force either.
+ */
+#ifndef SL_HEAP_HOOKS
+#ifdef NS3_BUILD_PROFILE_DEBUG
+#define SL_HEAP_HOOKS 1
+#else
+#define SL_HEAP_HOOKS 0
+#endif
+#endif
+
+namespace ns3
+{
+
+/**
+ * \brief Heap allocations of the calling thread.
+ *
+ * Counts the calls of the global operator new made by the current thread,
+ * which sl-heap-hooks.cc replaces for the whole executable when
+ * SL_HEAP_HOOKS is 1; the ns-3 libraries allocate through it as well, but
+ * other threads, such as the background database writer, are not counted.
+ * Blocks served by SlSpectrumArena do not reach the heap and are not counted.
+ */
+class SlHeapCounter
+{
+  public:
+    /// \return true if the allocator is replaced and the counter counts
+    static bool IsEnabled();
+
+    /// \return heap allocations of the calling thread since it started
+    static uint64_t GetAllocations();
+};
+
+} // namespace ns3
+
+#endif /* SL_HEAP_HOOKS_H */
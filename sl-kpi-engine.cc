@@ -0,0 +1,329 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-kpi-engine.h"
+
+#include "ns3/abort.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlKpiEngine");
+
+// Latency and PIR range, in seconds. Per link the buckets are ~27% wide,
+// for the whole run ~1.1%.
+static const double SKETCH_MIN = 1e-4;
+static const double SKETCH_MAX = 10.0;
+static const uint32_t LINK_BUCKETS = 48;
+static const uint32_t RUN_BUCKETS = 1024;
+
+SlQuantileSketch::SlQuantileSketch(double minValue, double maxValue, uint32_t buckets)
+    : m_minValue(minValue),
+      m_logMin(std::log(minValue)),
+      m_logWidth((std::log(maxValue) - std::log(minValue)) / buckets),
+      m_buckets(buckets, 0)
+{
+    NS_ABORT_MSG_UNLESS(minValue > 0 && maxValue > minValue && buckets > 0,
+                        "Invalid sketch range");
+}
+
+void
+SlQuantileSketch::Add(double value)
+{
+    int64_t bucket = 0;
+    if (value > m_minValue)
+    {
+        bucket = static_cast<int64_t>((std::log(value) - m_logMin) / m_logWidth);
+        bucket = std::min<int64_t>(bucket, m_buckets.size() - 1);
+    }
+    ++m_buckets[bucket];
+    if (m_count == 0 || value < m_min)
+    {
+        m_min = value;
+    }
+    if (m_count == 0 || value > m_max)
+    {
+        m_max = value;
+    }
+    ++m_count;
+    m_sum += value;
+}
+
+uint64_t
+SlQuantileSketch::GetCount() const
+{
+    return m_count;
+}
+
+double
+SlQuantileSketch::GetMean() const
+{
+    return m_count == 0 ? 0.0 : m_sum / m_count;
+}
+
+double
+SlQuantileSketch::GetMax() const
+{
+    return m_max;
+}
+
+double
+SlQuantileSketch::GetQuantile(double q) const
+{
+    if (m_count == 0)
+    {
+        return 0.0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * m_count));
+    rank = std::max<uint64_t>(rank, 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank)
+        {
+            // Geometric middle of the bucket, within the observed range
+            double value = std::exp(m_logMin + (i + 0.5) * m_logWidth);
+            return std::clamp(value, m_min, m_max);
+        }
+    }
+    return m_max;
+}
+
+SlKpiEngine::Link::Link()
+    : latency(SKETCH_MIN, SKETCH_MAX, LINK_BUCKETS),
+      pir(SKETCH_MIN, SKETCH_MAX, LINK_BUCKETS)
+{
+}
+
+/// \return the IP address of an IP, InetSocketAddress or Inet6SocketAddress
+static Address
+HostOf(const Address& address)
+{
+    if (InetSocketAddress::IsMatchingType(address))
+    {
+        return InetSocketAddress::ConvertFrom(address).GetIpv4();
+    }
+    if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        return Inet6SocketAddress::ConvertFrom(address).GetIpv6();
+    }
+    return address;
+}
+
+SlKpiEngine::SlKpiEngine(Time timeBin, double distanceBin, uint32_t distanceBins)
+    : m_timeBin(timeBin),
+      m_distanceBin(distanceBin),
+      m_expected(std::max<uint32_t>(distanceBins, 1), 0),
+      m_received(std::max<uint32_t>(distanceBins, 1), 0),
+      m_latency(SKETCH_MIN, SKETCH_MAX, RUN_BUCKETS),
+      m_pir(SKETCH_MIN, SKETCH_MAX, RUN_BUCKETS)
+{
+    NS_ABORT_MSG_UNLESS(timeBin.IsStrictlyPositive() && distanceBin > 0, "Invalid KPI bins");
+}
+
+void
+SlKpiEngine::AddTransmitter(Ptr<Node> node, const Address& address)
+{
+    m_transmitters[HostOf(address)] = node;
+}
+
+void
+SlKpiEngine::AddReceiver(Ptr<Node> node)
+{
+    if (std::find(m_receivers.begin(), m_receivers.end(), node) == m_receivers.end())
+    {
+        m_receivers.push_back(node);
+    }
+}
+
+void
+SlKpiEngine::Clear()
+{
+    m_links.clear();
+    m_timeBins.clear();
+    std::fill(m_expected.begin(), m_expected.end(), 0);
+    std::fill(m_received.begin(), m_received.end(), 0);
+    m_txPackets = 0;
+    m_txBytes = 0;
+    m_rxPackets = 0;
+    m_rxBytes = 0;
+    m_latency = SlQuantileSketch(SKETCH_MIN, SKETCH_MAX, RUN_BUCKETS);
+    m_pir = SlQuantileSketch(SKETCH_MIN, SKETCH_MAX, RUN_BUCKETS);
+}
+
+SlKpiEngine::TimeBin&
+SlKpiEngine::CurrentBin()
+{
+    size_t bin = Simulator::Now().GetTimeStep() / m_timeBin.GetTimeStep();
+    if (bin >= m_timeBins.size())
+    {
+        m_timeBins.resize(bin + 1);
+    }
+    return m_timeBins[bin];
+}
+
+uint32_t
+SlKpiEngine::DistanceBin(Ptr<Node> a, Ptr<Node> b) const
+{
+    double distance = a->GetObject<MobilityModel>()->GetDistanceFrom(b->GetObject<MobilityModel>());
+    return std::min<double>(distance / m_distanceBin, m_expected.size() - 1);
+}
+
+void
+SlKpiEngine::NotifyTx(Ptr<Node> tx, uint32_t bytes)
+{
+    ++m_txPackets;
+    m_txBytes += bytes;
+    ++CurrentBin().txPackets;
+    for (const auto& rx : m_receivers)
+    {
+        if (rx != tx)
+        {
+            ++m_expected[DistanceBin(tx, rx)];
+        }
+    }
+}
+
+void
+SlKpiEngine::NotifyRx(Ptr<Node> rx, const Address& from, uint32_t bytes, Time txTime)
+{
+    ++m_rxPackets;
+    m_rxBytes += bytes;
+    TimeBin& bin = CurrentBin();
+    ++bin.rxPackets;
+    bin.rxBytes += bytes;
+
+    double latency = (Simulator::Now() - txTime).GetSeconds();
+    m_latency.Add(latency);
+
+    auto it = m_transmitters.find(HostOf(from));
+    if (it == m_transmitters.end())
+    {
+        NS_LOG_WARN("Reception from unregistered transmitter " << from);
+        return;
+    }
+    Ptr<Node> tx = it->second;
+    ++m_received[DistanceBin(tx, rx)];
+
+    uint64_t key = (static_cast<uint64_t>(tx->GetId()) << 32) | rx->GetId();
+    Link& link = m_links[key];
+    if (link.rxPackets > 0)
+    {
+        double pir = (Simulator::Now() - link.lastRx).GetSeconds();
+        link.pir.Add(pir);
+        m_pir.Add(pir);
+    }
+    ++link.rxPackets;
+    link.rxBytes += bytes;
+    link.lastRx = Simulator::Now();
+    link.latency.Add(latency);
+}
+
+uint64_t
+SlKpiEngine::GetTxPackets() const
+{
+    return m_txPackets;
+}
+
+uint64_t
+SlKpiEngine::GetTxBytes() const
+{
+    return m_txBytes;
+}
+
+uint64_t
+SlKpiEngine::GetRxPackets() const
+{
+    return m_rxPackets;
+}
+
+uint64_t
+SlKpiEngine::GetRxBytes() const
+{
+    return m_rxBytes;
+}
+
+const SlQuantileSketch&
+SlKpiEngine::GetPir() const
+{
+    return m_pir;
+}
+
+const SlQuantileSketch&
+SlKpiEngine::GetLatency() const
+{
+    return m_latency;
+}
+
+void
+SlKpiEngine::Write(const std::string& prefix) const
+{
+    std::ofstream summary(prefix + "-kpi-summary.csv");
+    summary << "metric,value\n"
+            << "txPackets," << m_txPackets << "\n"
+            << "txBytes," << m_txBytes << "\n"
+            << "rxPackets," << m_rxPackets << "\n"
+            << "rxBytes," << m_rxBytes << "\n";
+    for (const auto& [name, sketch] : {std::make_pair("latency", &m_latency),
+                                       std::make_pair("pir", &m_pir)})
+    {
+        summary << name << "Count," << sketch->GetCount() << "\n"
+                << name << "Mean," << sketch->GetMean() << "\n"
+                << name << "P50," << sketch->GetQuantile(0.5) << "\n"
+                << name << "P90," << sketch->GetQuantile(0.9) << "\n"
+                << name << "P99," << sketch->GetQuantile(0.99) << "\n"
+                << name << "Max," << sketch->GetMax() << "\n";
+    }
+
+    std::ofstream links(prefix + "-kpi-links.csv");
+    links << "txNode,rxNode,rxPackets,rxBytes,latencyMean,latencyP50,latencyP99,"
+             "pirMean,pirP50,pirP99\n";
+    std::map<uint64_t, const Link*> sorted;
+    for (const auto& entry : m_links)
+    {
+        sorted[entry.first] = &entry.second;
+    }
+    for (const auto& [key, link] : sorted)
+    {
+        links << (key >> 32) << "," << (key & 0xffffffff) << "," << link->rxPackets << ","
+              << link->rxBytes << "," << link->latency.GetMean() << ","
+              << link->latency.GetQuantile(0.5) << "," << link->latency.GetQuantile(0.99) << ","
+              << link->pir.GetMean() << "," << link->pir.GetQuantile(0.5) << ","
+              << link->pir.GetQuantile(0.99) << "\n";
+    }
+
+    std::ofstream distance(prefix + "-kpi-distance.csv");
+    distance << "distanceMin,distanceMax,expected,received,pdr\n";
+    for (size_t i = 0; i < m_expected.size(); ++i)
+    {
+        distance << i * m_distanceBin << ",";
+        if (i + 1 < m_expected.size())
+        {
+            distance << (i + 1) * m_distanceBin;
+        }
+        distance << "," << m_expected[i] << "," << m_received[i] << ","
+                 << (m_expected[i] == 0 ? 0.0 : double(m_received[i]) / m_expected[i]) << "\n";
+    }
+
+    std::ofstream time(prefix + "-kpi-time.csv");
+    time << "timeStart,txPackets,rxPackets,rxBytes,throughputKbps\n";
+    for (size_t i = 0; i < m_timeBins.size(); ++i)
+    {
+        const TimeBin& bin = m_timeBins[i];
+        time << m_timeBin.GetSeconds() * i << "," << bin.txPackets << "," << bin.rxPackets
+             << "," << bin.rxBytes << ","
+             << bin.rxBytes * 8 / m_timeBin.GetSeconds() / 1000.0 << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,191 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_KPI_ENGINE_H
+#define SL_KPI_ENGINE_H
+
+#include "ns3/address.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Fixed-size quantile sketch of positive values.
+ *
+ * Values between minValue and maxValue fall into logarithmic buckets, so
+ * every quantile is known within a constant relative error of
+ * (maxValue / minValue)^(1 / buckets) no matter how many values were
+ * added; values outside the range are clamped into the first or last
+ * bucket. Count, sum, minimum and maximum are exact.
+ */
+class SlQuantileSketch
+{
+  public:
+    /**
+     * \param minValue lower bound of the logarithmic range, > 0
+     * \param maxValue upper bound of the logarithmic range
+     * \param buckets number of buckets
+     */
+    SlQuantileSketch(double minValue, double maxValue, uint32_t buckets);
+
+    /// \param value sample
+    void Add(double value);
+
+    /// \return number of samples
+    uint64_t GetCount() const;
+    /// \return mean of the samples, 0 if there are none
+    double GetMean() const;
+    /// \return largest sample, 0 if there are none
+    double GetMax() const;
+    /**
+     * \param q quantile, in [0, 1]
+     * \return estimate of the quantile, 0 if there are no samples
+     */
+    double GetQuantile(double q) const;
+
+  private:
+    double m_minValue;               //!< lower bound of the range
+    double m_logMin;                 //!< log (m_minValue)
+    double m_logWidth;               //!< log width of a bucket
+    std::vector<uint32_t> m_buckets; //!< sample count of every bucket
+    uint64_t m_count{0};             //!< samples
+    double m_sum{0};                 //!< sum of the samples
+    double m_min{0};                 //!< smallest sample
+    double m_max{0};                 //!< largest sample
+};
+
+/**
+ * \brief KPIs of the sidelink applications, aggregated during the run.
+ *
+ * Replaces the global counters of nr-v2x-simple-demo (txByteCounter,
+ * rxByteCounter, pir, pirCounter) and lets large runs skip the per-packet
+ * pktTxRx rows. Memory does not grow with the number of packets:
+ *
+ * - per link (transmitter, receiver): packets, bytes, and latency and
+ *   packet inter-reception (PIR) sketches;
+ * - per time bin: packets transmitted and received, bytes received;
+ * - per distance bin: receptions expected (one per registered receiver at
+ *   every transmission) and received, i.e. PDR versus distance;
+ * - whole run: latency and PIR sketches with finer buckets.
+ *
+ * The distance of a reception is taken at the reception time; with
+ * millisecond latencies the nodes have not moved noticeably.
+ */
+class SlKpiEngine
+{
+  public:
+    /**
+     * \param timeBin width of the time bins
+     * \param distanceBin width of the distance bins, in meters
+     * \param distanceBins number of distance bins, the last one is open
+     */
+    SlKpiEngine(Time timeBin, double distanceBin, uint32_t distanceBins);
+
+    /**
+     * Register a node whose transmissions are received through \p address.
+     * \param node the transmitter
+     * \param address IPv4 or IPv6 address of the transmitter
+     */
+    void AddTransmitter(Ptr<Node> node, const Address& address);
+
+    /**
+     * Register a node expected to receive every transmission; a node
+     * running several sinks is registered once.
+     * \param node the receiver
+     */
+    void AddReceiver(Ptr<Node> node);
+
+    /**
+     * \param tx transmitter
+     * \param bytes packet size
+     */
+    void NotifyTx(Ptr<Node> tx, uint32_t bytes);
+
+    /**
+     * \param rx receiver
+     * \param from source address of the packet
+     * \param bytes packet size
+     * \param txTime time the packet was sent
+     */
+    void NotifyRx(Ptr<Node> rx, const Address& from, uint32_t bytes, Time txTime);
+
+    /**
+     * Drop the KPIs gathered so far, keeping the registered nodes; the
+     * time bins keep counting from the start of the run.
+     */
+    void Clear();
+
+    /// \return packets transmitted
+    uint64_t GetTxPackets() const;
+    /// \return bytes transmitted
+    uint64_t GetTxBytes() const;
+    /// \return packets received
+    uint64_t GetRxPackets() const;
+    /// \return bytes received
+    uint64_t GetRxBytes() const;
+    /// \return PIR of all links
+    const SlQuantileSketch& GetPir() const;
+    /// \return latency of all links
+    const SlQuantileSketch& GetLatency() const;
+
+    /**
+     * Write <prefix>-kpi-summary.csv, -kpi-links.csv, -kpi-distance.csv and
+     * -kpi-time.csv.
+     * \param prefix output path without suffix
+     */
+    void Write(const std::string& prefix) const;
+
+  private:
+    /// KPIs of one transmitter-receiver pair.
+    struct Link
+    {
+        Link();
+
+        uint64_t rxPackets{0};    //!< packets received
+        uint64_t rxBytes{0};      //!< bytes received
+        Time lastRx;              //!< time of the last reception
+        SlQuantileSketch latency; //!< latency, in seconds
+        SlQuantileSketch pir;     //!< packet inter-reception, in seconds
+    };
+
+    /// Counters of one time bin.
+    struct TimeBin
+    {
+        uint64_t txPackets{0}; //!< packets transmitted
+        uint64_t rxPackets{0}; //!< packets received
+        uint64_t rxBytes{0};   //!< bytes received
+    };
+
+    /// \return the bin of the current time, created if needed
+    TimeBin& CurrentBin();
+    /// \return the distance bin of two nodes
+    uint32_t DistanceBin(Ptr<Node> a, Ptr<Node> b) const;
+
+    Time m_timeBin;                              //!< width of the time bins
+    double m_distanceBin;                        //!< width of the distance bins
+    std::map<Address, Ptr<Node>> m_transmitters; //!< address of every transmitter
+    std::vector<Ptr<Node>> m_receivers;          //!< expected receivers
+    std::unordered_map<uint64_t, Link> m_links;  //!< key: tx id << 32 | rx id
+    std::vector<TimeBin> m_timeBins;             //!< counters per time bin
+    std::vector<uint64_t> m_expected;            //!< receptions expected per distance
+    std::vector<uint64_t> m_received;            //!< receptions per distance
+    uint64_t m_txPackets{0};                     //!< packets transmitted
+    uint64_t m_txBytes{0};                       //!< bytes transmitted
+    uint64_t m_rxPackets{0};                     //!< packets received
+    uint64_t m_rxBytes{0};                       //!< bytes received
+    SlQuantileSketch m_latency;                  //!< latency of all links
+    SlQuantileSketch m_pir;                      //!< PIR of all links
+};
+
+} // namespace ns3
+
+#endif /* SL_KPI_ENGINE_H */
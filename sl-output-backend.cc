@@ -0,0 +1,41 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-output-backend.h"
+
+#include "ns3/abort.h"
+
+namespace ns3
+{
+
+SlOutputBackend::Format
+SlOutputBackend::ParseFormat(const std::string& name)
+{
+    if (name == "sqlite")
+    {
+        return SQLITE;
+    }
+    if (name == "columnar")
+    {
+        return COLUMNAR;
+    }
+    NS_ABORT_MSG("Unknown output format " << name << ", use sqlite or columnar");
+    return SQLITE;
+}
+
+SlOutputBackend::SlOutputBackend(Format format,
+                                 const std::string& prefix,
+                                 uint32_t batchSize,
+                                 bool backgroundWriter)
+    : m_format(format),
+      m_prefix(prefix),
+      m_batchSize(batchSize)
+{
+    if (m_format == SQLITE)
+    {
+        m_db = std::make_unique<SQLiteOutput>(m_prefix + ".db");
+        m_writer = ns3::Create<SqliteBatchWriter>(m_db.get(), backgroundWriter);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,172 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_OUTPUT_BACKEND_H
+#define SL_OUTPUT_BACKEND_H
+
+#include "batched-sl-output-stats.h"
+#include "columnar-sl-output-stats.h"
+#include "sim-profiler.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief Sink timing the calls of another sink for SimProfiler.
+ */
+template <typename Record>
+class ProfiledSlRecordSink : public SlRecordSink<Record>
+{
+  public:
+    /**
+     * \param sink the timed sink
+     * \param tableName name of its table, used in the report
+     */
+    ProfiledSlRecordSink(std::unique_ptr<SlRecordSink<Record>> sink, const std::string& tableName)
+        : m_sink(std::move(sink)),
+          m_save(SimProfiler::Get().NameIndex(tableName + " Save", "stats-output")),
+          m_emptyCache(SimProfiler::Get().NameIndex(tableName + " EmptyCache", "stats-output"))
+    {
+    }
+
+    void Save(const Record& record) override
+    {
+        auto start = std::chrono::steady_clock::now();
+        m_sink->Save(record);
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        SimProfiler::Get().AddCall(m_save, wall.count());
+    }
+
+    void EmptyCache() override
+    {
+        auto start = std::chrono::steady_clock::now();
+        m_sink->EmptyCache();
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        SimProfiler::Get().AddCall(m_emptyCache, wall.count());
+    }
+
+  private:
+    std::unique_ptr<SlRecordSink<Record>> m_sink; //!< the timed sink
+    uint32_t m_save;                              //!< profiler entry of Save
+    uint32_t m_emptyCache;                        //!< profiler entry of EmptyCache
+};
+
+/**
+ * \brief Sink forwarding to a sink attached later, dropping the records
+ * saved before.
+ *
+ * Lets the trace sinks be connected before the output is opened, e.g. by
+ * the branches of an SlBranchPoint, which open their own files. Records
+ * buffered upstream, such as those of an SlTraceWiring, reach the sink
+ * attached next unless they are discarded first.
+ */
+template <typename Record>
+class SlDeferredSink : public SlRecordSink<Record>
+{
+  public:
+    /// \param sink sink receiving the records from now on
+    void Attach(std::unique_ptr<SlRecordSink<Record>> sink)
+    {
+        m_sink = std::move(sink);
+    }
+
+    void Save(const Record& record) override
+    {
+        if (m_sink)
+        {
+            m_sink->Save(record);
+        }
+    }
+
+    void EmptyCache() override
+    {
+        if (m_sink)
+        {
+            m_sink->EmptyCache();
+        }
+    }
+
+  private:
+    std::unique_ptr<SlRecordSink<Record>> m_sink; //!< attached sink, may be null
+};
+
+/**
+ * \brief Output format of the sidelink stats, chosen at start-up.
+ *
+ * - "sqlite": one database, <prefix>.db, with one table per stats, written
+ *   in batched transactions (BatchedSlOutputStats).
+ * - "columnar": one <prefix>-<table>.slc file per stats
+ *   (ColumnarSlOutputStats), read with sweep/sl_columnar.py.
+ *
+ * The sinks returned by Create() use the backend and must be destroyed
+ * before it. With SimProfiler installed, their calls are timed.
+ */
+class SlOutputBackend
+{
+  public:
+    /// Supported formats.
+    enum Format
+    {
+        SQLITE,
+        COLUMNAR,
+    };
+
+    /**
+     * \param name "sqlite" or "columnar"
+     * \return the format, aborts on unknown names
+     */
+    static Format ParseFormat(const std::string& name);
+
+    /**
+     * \param format output format
+     * \param prefix output path without extension
+     * \param batchSize rows per transaction or per row group
+     * \param backgroundWriter write SQLite batches from a thread
+     */
+    SlOutputBackend(Format format,
+                    const std::string& prefix,
+                    uint32_t batchSize,
+                    bool backgroundWriter);
+
+    /**
+     * \param tableName name of the table
+     * \return the sink of the table
+     */
+    template <typename Record>
+    std::unique_ptr<SlRecordSink<Record>> Create(const std::string& tableName)
+    {
+        std::unique_ptr<SlRecordSink<Record>> sink;
+        if (m_format == COLUMNAR)
+        {
+            auto stats = std::make_unique<ColumnarSlOutputStats<Record>>();
+            stats->Open(m_prefix + "-" + tableName + ".slc", m_batchSize);
+            sink = std::move(stats);
+        }
+        else
+        {
+            auto stats = std::make_unique<BatchedSlOutputStats<Record>>();
+            stats->SetDb(m_writer, tableName, m_batchSize);
+            sink = std::move(stats);
+        }
+        if (SimProfiler::IsEnabled())
+        {
+            sink = std::make_unique<ProfiledSlRecordSink<Record>>(std::move(sink), tableName);
+        }
+        return sink;
+    }
+
+  private:
+    Format m_format;                    //!< output format
+    std::string m_prefix;               //!< output path without extension
+    uint32_t m_batchSize;               //!< rows per batch
+    std::unique_ptr<SQLiteOutput> m_db; //!< SQLITE only
+    Ptr<SqliteBatchWriter> m_writer;    //!< SQLITE only, released before m_db
+};
+
+} // namespace ns3
+
+#endif /* SL_OUTPUT_BACKEND_H */
@@ -0,0 +1,268 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_OUTPUT_RECORDS_H
+#define SL_OUTPUT_RECORDS_H
+
+#include "ns3/nr-sl-phy-mac-common.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace ns3
+{
+
+/**
+ * \brief Seed and run written in the SEED and RUN columns.
+ */
+struct SlOutputSeedRun
+{
+    uint32_t seed{0}; //!< RngSeedManager::GetSeed ()
+    uint64_t run{0};  //!< RngSeedManager::GetRun ()
+
+    /// \return the values of this simulation, read once
+    static const SlOutputSeedRun& Get();
+};
+
+/**
+ * \brief One row of the "pktTxRx" table, as saved by UePacketTraceDb.
+ */
+struct PktTxRxRecord
+{
+    double timeSec{0.0};   //!< time of the trace
+    std::string txRx;      //!< "tx" or "rx"
+    uint32_t nodeId{0};    //!< node id
+    uint64_t imsi{0};      //!< IMSI of the UE
+    uint32_t pktSize{0};   //!< size including the SeqTsSizeHeader
+    std::string srcIp;     //!< source address
+    uint16_t srcPort{0};   //!< source port
+    std::string dstIp;     //!< destination address
+    uint16_t dstPort{0};   //!< destination port
+    uint32_t pktSeqNum{0}; //!< SeqTsSizeHeader sequence number
+};
+
+/**
+ * \brief Column layout of the records written by the sidelink stats.
+ *
+ * Visit(record, v) calls v(name, value) for every column, in table order,
+ * so the same description drives table creation, row binding and any other
+ * output format. Values are arithmetic types or std::string. The layouts
+ * are the ones of the tables written by the nr stats classes, so existing
+ * post-processing keeps working. SEED and RUN are appended by the writers.
+ */
+template <typename Record>
+struct RecordSchema;
+
+template <>
+struct RecordSchema<SlPscchUeMacStatParameters>
+{
+    template <typename V>
+    static void Visit(const SlPscchUeMacStatParameters& p, V&& v)
+    {
+        v("timeMs", p.timeMs);
+        v("imsi", p.imsi);
+        v("rnti", p.rnti);
+        v("frame", p.frameNum);
+        v("subFrame", p.subframeNum);
+        v("slot", p.slotNum);
+        v("symStart", p.symStart);
+        v("symLength", p.symLength);
+        v("rbStart", p.rbStart);
+        v("rbLength", p.rbLength);
+        v("priority", p.priority);
+        v("mcs", p.mcs);
+        v("tbSize", p.tbSize);
+        v("rsvpPeriod", p.slResourceReservePeriod);
+        v("totSbCh", p.totalSubChannels);
+        v("sbChStart", p.slPsschSubChStart);
+        v("sbChLength", p.slPsschSubChLength);
+        v("maxNumPerReserve", p.slMaxNumPerReserve);
+        v("gapReTx1", p.gapReTx1);
+        v("gapReTx2", p.gapReTx2);
+    }
+};
+
+template <>
+struct RecordSchema<SlPsschUeMacStatParameters>
+{
+    template <typename V>
+    static void Visit(const SlPsschUeMacStatParameters& p, V&& v)
+    {
+        v("timeMs", p.timeMs);
+        v("imsi", p.imsi);
+        v("rnti", p.rnti);
+        v("frame", p.frameNum);
+        v("subFrame", p.subframeNum);
+        v("slot", p.slotNum);
+        v("symStart", p.symStart);
+        v("symLength", p.symLength);
+        v("sbChSize", p.subChannelSize);
+        v("rbStart", p.rbStart);
+        v("rbLength", p.rbLength);
+        v("harqId", p.harqId);
+        v("ndi", p.ndi);
+        v("rv", p.rv);
+        v("srcL2Id", p.srcL2Id);
+        v("dstL2Id", p.dstL2Id);
+        v("csiReq", p.csiReq);
+        v("castType", p.castType);
+        v("resoReselCounter", p.resoReselCounter);
+        v("cReselCounter", p.cReselCounter);
+    }
+};
+
+template <>
+struct RecordSchema<SlRxCtrlPacketTraceParams>
+{
+    template <typename V>
+    static void Visit(const SlRxCtrlPacketTraceParams& p, V&& v)
+    {
+        v("timeMs", p.m_timeMs);
+        v("cellId", p.m_cellId);
+        v("rnti", p.m_rnti);
+        v("bwpId", p.m_bwpId);
+        v("frame", p.m_frameNum);
+        v("subFrame", p.m_subframeNum);
+        v("slot", p.m_slotNum);
+        v("txRnti", p.m_txRnti);
+        v("symStart", p.m_symStart);
+        v("symLength", p.m_numSym);
+        v("rbStart", p.m_rbStart);
+        v("rbLength", p.m_rbAssignedNum);
+        v("priority", p.m_priority);
+        v("mcs", p.m_mcs);
+        v("tbSize", p.m_tbSize);
+        v("rsvpPeriod", p.m_slResourceReservePeriod);
+        v("totSbCh", p.m_totalSubChannels);
+        v("sbChStart", p.m_indexStartSubChannel);
+        v("sbChLength", p.m_lengthSubChannel);
+        v("maxNumPerReserve", p.m_maxNumPerReserve);
+        v("gapReTx1", p.m_gapReTx1);
+        v("gapReTx2", p.m_gapReTx2);
+        v("avrgSinr", p.m_sinr);
+        v("minSinr", p.m_minSinr);
+        v("tbler", p.m_tbler);
+        v("corrupt", p.m_corrupt);
+    }
+};
+
+template <>
+struct RecordSchema<SlRxDataPacketTraceParams>
+{
+    template <typename V>
+    static void Visit(const SlRxDataPacketTraceParams& p, V&& v)
+    {
+        v("timeMs", p.m_timeMs);
+        v("cellId", p.m_cellId);
+        v("rnti", p.m_rnti);
+        v("bwpId", p.m_bwpId);
+        v("frame", p.m_frameNum);
+        v("subFrame", p.m_subframeNum);
+        v("slot", p.m_slotNum);
+        v("txRnti", p.m_txRnti);
+        v("srcL2Id", p.m_srcL2Id);
+        v("dstL2Id", p.m_dstL2Id);
+        v("symStart", p.m_symStart);
+        v("symLength", p.m_numSym);
+        v("rbStart", p.m_rbStart);
+        v("rbLength", p.m_rbAssignedNum);
+        v("mcs", p.m_mcs);
+        v("ndi", p.m_ndi);
+        v("rv", p.m_rv);
+        v("tbSize", p.m_tbSize);
+        v("avrgSinr", p.m_sinr);
+        v("minSinr", p.m_minSinr);
+        v("tbler", p.m_tbler);
+        v("corrupt", p.m_corrupt);
+        v("sci2Tbler", p.m_sci2Tbler);
+        v("sci2Corrupted", p.m_sci2Corrupted);
+    }
+};
+
+template <>
+struct RecordSchema<PktTxRxRecord>
+{
+    template <typename V>
+    static void Visit(const PktTxRxRecord& p, V&& v)
+    {
+        v("timeSec", p.timeSec);
+        v("txRx", p.txRx);
+        v("nodeId", p.nodeId);
+        v("imsi", p.imsi);
+        v("pktSizeBytes", p.pktSize);
+        v("srcIp", p.srcIp);
+        v("srcPort", p.srcPort);
+        v("dstIp", p.dstIp);
+        v("dstPort", p.dstPort);
+        v("pktSeqNum", p.pktSeqNum);
+    }
+};
+
+/**
+ * \brief Destination of the records of one sidelink stats table.
+ *
+ * Implemented by every output backend, so the trace sinks do not depend on
+ * the format selected at start-up.
+ */
+template <typename Record>
+class SlRecordSink
+{
+  public:
+    virtual ~SlRecordSink() = default;
+
+    /// \param record row to be written
+    virtual void Save(const Record& record) = 0;
+
+    /// Write every row saved so far.
+    virtual void EmptyCache() = 0;
+};
+
+/**
+ * \return the SQL type of a column holding values of type T
+ */
+template <typename T>
+const char*
+SqlTypeOf()
+{
+    if (std::is_floating_point<T>::value)
+    {
+        return "DOUBLE";
+    }
+    if (std::is_arithmetic<T>::value)
+    {
+        return "INTEGER";
+    }
+    return "TEXT";
+}
+
+/**
+ * \return "name TYPE NOT NULL, ..." for the columns of Record
+ */
+template <typename Record>
+std::string
+SqlColumns()
+{
+    std::string columns;
+    RecordSchema<Record>::Visit(Record(), [&columns](const char* name, const auto& value) {
+        columns += std::string(name) + " " +
+                   SqlTypeOf<std::decay_t<decltype(value)>>() + " NOT NULL, ";
+    });
+    return columns + "SEED INTEGER NOT NULL, RUN INTEGER NOT NULL";
+}
+
+/**
+ * \return the number of columns of Record, SEED and RUN excluded
+ */
+template <typename Record>
+uint32_t
+ColumnCount()
+{
+    uint32_t n = 0;
+    RecordSchema<Record>::Visit(Record(), [&n](const char*, const auto&) { ++n; });
+    return n;
+}
+
+} // namespace ns3
+
+#endif /* SL_OUTPUT_RECORDS_H */
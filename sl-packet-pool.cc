@@ -0,0 +1,52 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-packet-pool.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlPacketPool");
+
+SlPacketPool::SlPacketPool(uint32_t payloadSize)
+    : m_payloadSize(payloadSize)
+{
+}
+
+Ptr<Packet>
+SlPacketPool::Acquire()
+{
+    // Round robin: the oldest packet is the most likely to be released
+    for (size_t checked = 0; checked < m_pool.size(); ++checked)
+    {
+        Ptr<Packet>& packet = m_pool[m_next];
+        m_next = (m_next + 1) % m_pool.size();
+        if (packet->GetReferenceCount() == 1)
+        {
+            *packet = Packet(m_payloadSize);
+            ++m_reused;
+            return packet;
+        }
+    }
+    Ptr<Packet> packet = Create<Packet>(m_payloadSize);
+    m_pool.push_back(packet);
+    m_next = 0;
+    NS_LOG_INFO("Pool grown to " << m_pool.size() << " packets");
+    return packet;
+}
+
+uint64_t
+SlPacketPool::GetCreated() const
+{
+    return m_pool.size();
+}
+
+uint64_t
+SlPacketPool::GetReused() const
+{
+    return m_reused;
+}
+
+} // namespace ns3
@@ -0,0 +1,55 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_PACKET_POOL_H
+#define SL_PACKET_POOL_H
+
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Recycled Packet objects for a fixed-size application payload.
+ *
+ * Acquire() returns a packet of the payload size, reusing a pooled Packet
+ * once nobody else holds a reference to it (the sockets send a copy, so the
+ * application packet is released as soon as the send and its traces
+ * return). A reused packet is overwritten by a fresh Packet(payloadSize):
+ * it gets a new uid and no tags or headers, and its payload is the virtual
+ * zero area of Buffer, whose data blocks ns-3 already recycles. Only the
+ * Packet objects themselves are pooled, which removes their heap allocation
+ * from the send path in steady state.
+ */
+class SlPacketPool
+{
+  public:
+    /// \param payloadSize size of the packets returned by Acquire()
+    explicit SlPacketPool(uint32_t payloadSize);
+
+    SlPacketPool(const SlPacketPool&) = delete;
+    SlPacketPool& operator=(const SlPacketPool&) = delete;
+
+    /// \return a packet of the payload size, with a new uid
+    Ptr<Packet> Acquire();
+
+    /// \return Packet objects allocated by the pool
+    uint64_t GetCreated() const;
+
+    /// \return packets served by reusing a pooled Packet
+    uint64_t GetReused() const;
+
+  private:
+    uint32_t m_payloadSize;          //!< size of the packets
+    std::vector<Ptr<Packet>> m_pool; //!< every packet created
+    size_t m_next{0};                //!< next packet checked for reuse
+    uint64_t m_reused{0};            //!< packets reused
+};
+
+} // namespace ns3
+
+#endif /* SL_PACKET_POOL_H */
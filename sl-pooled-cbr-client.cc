@@ -0,0 +1,172 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-pooled-cbr-client.h"
+
+#include "ns3/abort.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlPooledCbrClient");
+
+NS_OBJECT_ENSURE_REGISTERED(SlPooledCbrClient);
+
+TypeId
+SlPooledCbrClient::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlPooledCbrClient")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<SlPooledCbrClient>()
+            .AddAttribute("Remote",
+                          "The address of the destination",
+                          AddressValue(),
+                          MakeAddressAccessor(&SlPooledCbrClient::m_peer),
+                          MakeAddressChecker())
+            .AddAttribute("PacketSize",
+                          "The size of the packets, SeqTsSizeHeader included",
+                          UintegerValue(512),
+                          MakeUintegerAccessor(&SlPooledCbrClient::m_packetSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("DataRate",
+                          "The sending rate",
+                          DataRateValue(DataRate("500kb/s")),
+                          MakeDataRateAccessor(&SlPooledCbrClient::m_rate),
+                          MakeDataRateChecker())
+            .AddAttribute("WarmUp",
+                          "Packets sent before the steady-state allocation counts",
+                          UintegerValue(100),
+                          MakeUintegerAccessor(&SlPooledCbrClient::m_warmUp),
+                          MakeUintegerChecker<uint32_t>())
+            .AddTraceSource("Tx",
+                            "A new packet is sent",
+                            MakeTraceSourceAccessor(&SlPooledCbrClient::m_txTrace),
+                            "ns3::Packet::TracedCallback")
+            .AddTraceSource("TxWithSeqTsSize",
+                            "A new packet is created, before its SeqTsSizeHeader is added",
+                            MakeTraceSourceAccessor(&SlPooledCbrClient::m_txTraceWithSeqTsSize),
+                            "ns3::SlPooledCbrClient::SeqTsSizeCallback");
+    return tid;
+}
+
+SlPooledCbrClient::SlPooledCbrClient()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlPooledCbrClient::~SlPooledCbrClient()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+SlPooledCbrClient::GetSent() const
+{
+    return m_sent;
+}
+
+uint64_t
+SlPooledCbrClient::GetSteadySent() const
+{
+    return m_steadySent;
+}
+
+uint64_t
+SlPooledCbrClient::GetSteadyAllocations() const
+{
+    return m_steadyAllocations;
+}
+
+const SlPacketPool*
+SlPooledCbrClient::GetPool() const
+{
+    return m_pool.get();
+}
+
+void
+SlPooledCbrClient::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_socket = nullptr;
+    Application::DoDispose();
+}
+
+void
+SlPooledCbrClient::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    SeqTsSizeHeader header;
+    NS_ABORT_MSG_IF(m_packetSize < header.GetSerializedSize(),
+                    "PacketSize smaller than SeqTsSizeHeader");
+    if (!m_pool)
+    {
+        m_pool = std::make_unique<SlPacketPool>(m_packetSize - header.GetSerializedSize());
+    }
+    if (!m_socket)
+    {
+        m_socket = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        int ret = Inet6SocketAddress::IsMatchingType(m_peer) ? m_socket->Bind6()
+                                                              : m_socket->Bind();
+        NS_ABORT_MSG_IF(ret == -1 || m_socket->Connect(m_peer) == -1,
+                        "Failed to bind or connect the socket");
+        m_socket->SetAllowBroadcast(true);
+        m_socket->ShutdownRecv();
+    }
+    m_sendEvent = Simulator::Schedule(m_rate.CalculateBytesTxTime(m_packetSize),
+                                      &SlPooledCbrClient::Send,
+                                      this);
+}
+
+void
+SlPooledCbrClient::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_sendEvent.Cancel();
+    if (m_socket)
+    {
+        m_socket->Close();
+    }
+}
+
+void
+SlPooledCbrClient::Send()
+{
+    NS_LOG_FUNCTION(this);
+    uint64_t allocations = SlHeapCounter::GetAllocations();
+
+    Address from;
+    Address to;
+    m_socket->GetSockName(from);
+    m_socket->GetPeerName(to);
+    SeqTsSizeHeader header;
+    header.SetSeq(m_seq++);
+    header.SetSize(m_packetSize);
+    Ptr<Packet> packet = m_pool->Acquire();
+    m_txTraceWithSeqTsSize(packet, from, to, header);
+    packet->AddHeader(header);
+    if (m_socket->Send(packet) == static_cast<int>(m_packetSize))
+    {
+        m_txTrace(packet);
+    }
+    packet = nullptr;
+
+    if (++m_sent > m_warmUp)
+    {
+        ++m_steadySent;
+        m_steadyAllocations += SlHeapCounter::GetAllocations() - allocations;
+    }
+    m_sendEvent = Simulator::Schedule(m_rate.CalculateBytesTxTime(m_packetSize),
+                                      &SlPooledCbrClient::Send,
+                                      this);
+}
+
+} // namespace ns3
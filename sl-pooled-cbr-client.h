@@ -0,0 +1,106 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_POOLED_CBR_CLIENT_H
+#define SL_POOLED_CBR_CLIENT_H
+
+#include "sl-heap-hooks.h"
+#include "sl-packet-pool.h"
+
+#include "ns3/address.h"
+#include "ns3/application.h"
+#include "ns3/data-rate.h"
+#include "ns3/event-id.h"
+#include "ns3/seq-ts-size-header.h"
+#include "ns3/socket.h"
+#include "ns3/traced-callback.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace ns3
+{
+
+/**
+ * \brief Constant bit rate UDP client sending from an SlPacketPool.
+ *
+ * Sends what an OnOffApplication always on, set with SetConstantRate and
+ * EnableSeqTsSizeHeader, sends: PacketSize-byte packets, SeqTsSizeHeader
+ * included, every PacketSize * 8 / DataRate seconds, the first one an
+ * interval after the start. The TxWithSeqTsSize trace has the same
+ * signature and timing (before the header is added), so the sinks of
+ * OnOffApplication can be connected unchanged.
+ *
+ * The heap allocations the simulation thread makes while sending are
+ * counted with SlHeapCounter, separately for the first WarmUp packets.
+ * They include the synchronous part of the stack below the socket (the
+ * copy the socket sends, headers, tags and the NR layers it reaches), of
+ * which the pool only removes the application's own Packet; the figure
+ * therefore does not drop to zero.
+ */
+class SlPooledCbrClient : public Application
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlPooledCbrClient();
+    ~SlPooledCbrClient() override;
+
+    /// \return packets sent
+    uint64_t GetSent() const;
+
+    /// \return packets sent after the warm-up
+    uint64_t GetSteadySent() const;
+
+    /// \return heap allocations while sending the packets after the warm-up
+    uint64_t GetSteadyAllocations() const;
+
+    /// \return the packet pool, null before the start
+    const SlPacketPool* GetPool() const;
+
+    /**
+     * TracedCallback signature of TxWithSeqTsSize.
+     * \param packet the packet, without the header
+     * \param from local address
+     * \param to peer address
+     * \param header the header added to the packet
+     */
+    typedef void (*SeqTsSizeCallback)(Ptr<const Packet> packet,
+                                      const Address& from,
+                                      const Address& to,
+                                      const SeqTsSizeHeader& header);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// Send one packet and schedule the next.
+    void Send();
+
+    Address m_peer;                       //!< destination
+    uint32_t m_packetSize;                //!< size of the packets, header included
+    DataRate m_rate;                      //!< sending rate
+    uint32_t m_warmUp;                    //!< packets left out of the steady counts
+    Ptr<Socket> m_socket;                 //!< UDP socket
+    std::unique_ptr<SlPacketPool> m_pool; //!< packets of the payload size
+    EventId m_sendEvent;                  //!< next Send()
+    uint32_t m_seq{0};                    //!< sequence number of the next packet
+    uint64_t m_sent{0};                   //!< packets sent
+    uint64_t m_steadySent{0};             //!< packets sent after the warm-up
+    uint64_t m_steadyAllocations{0};      //!< heap allocations sending them
+
+    TracedCallback<Ptr<const Packet>> m_txTrace; //!< packets sent
+    TracedCallback<Ptr<const Packet>, const Address&, const Address&, const SeqTsSizeHeader&>
+        m_txTraceWithSeqTsSize; //!< packets sent, with their header
+};
+
+} // namespace ns3
+
+#endif /* SL_POOLED_CBR_CLIENT_H */
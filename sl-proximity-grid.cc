@@ -0,0 +1,102 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-proximity-grid.h"
+
+#include "ns3/abort.h"
+#include "ns3/callback.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+SlProximityGrid::SlProximityGrid(double cellSize, Time refresh)
+    : m_cellSize(cellSize),
+      m_refresh(refresh)
+{
+    NS_ABORT_MSG_UNLESS(cellSize > 0, "The cells of the grid must have a positive size");
+}
+
+uint32_t
+SlProximityGrid::Add(Ptr<MobilityModel> mobility)
+{
+    uint32_t id = m_members.size();
+    m_members.push_back(Member{mobility, 0, 0, false});
+    Vector position = mobility->GetPosition();
+    Member& member = m_members.back();
+    member.cell = CellKey(CellCoordinate(position.x), CellCoordinate(position.y));
+    auto& bucket = m_cells[member.cell];
+    member.slot = bucket.size();
+    bucket.push_back(id);
+    mobility->TraceConnectWithoutContext(
+        "CourseChange",
+        MakeBoundCallback(&SlProximityGrid::CourseChanged, this, id));
+    CourseChanged(this, id, mobility);
+    return id;
+}
+
+uint32_t
+SlProximityGrid::GetN() const
+{
+    return m_members.size();
+}
+
+void
+SlProximityGrid::Place(uint32_t id)
+{
+    Member& member = m_members[id];
+    Vector position = member.mobility->GetPosition();
+    uint64_t cell = CellKey(CellCoordinate(position.x), CellCoordinate(position.y));
+    if (cell == member.cell)
+    {
+        return;
+    }
+    // Swap-remove from the old bucket, fixing the slot of the moved member
+    auto& old = m_cells[member.cell];
+    uint32_t last = old.back();
+    old[member.slot] = last;
+    m_members[last].slot = member.slot;
+    old.pop_back();
+    if (old.empty())
+    {
+        m_cells.erase(member.cell);
+    }
+    auto& bucket = m_cells[cell];
+    member.cell = cell;
+    member.slot = bucket.size();
+    bucket.push_back(id);
+}
+
+void
+SlProximityGrid::Refresh()
+{
+    if (Simulator::Now() - m_lastRefresh < m_refresh)
+    {
+        return;
+    }
+    m_lastRefresh = Simulator::Now();
+    for (uint32_t id = 0; id < m_members.size(); ++id)
+    {
+        if (m_members[id].moving)
+        {
+            Place(id);
+        }
+    }
+}
+
+void
+SlProximityGrid::CourseChanged(SlProximityGrid* grid,
+                               uint32_t id,
+                               Ptr<const MobilityModel> mobility)
+{
+    Vector velocity = mobility->GetVelocity();
+    double speed = std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y +
+                             velocity.z * velocity.z);
+    grid->m_members[id].moving = speed > 0;
+    grid->m_maxSpeed = std::max(grid->m_maxSpeed, speed);
+    grid->Place(id);
+}
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_PROXIMITY_GRID_H
+#define SL_PROXIMITY_GRID_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Uniform grid of moving objects, for range queries.
+ *
+ * Members are bucketed by the (x, y) cell of their position. The bucket of
+ * a member is updated by the CourseChange trace of its MobilityModel and,
+ * for members moving between course changes (ns-2 traces set a velocity
+ * and let the node move), every refresh period. A member may therefore be
+ * up to maxSpeed * refresh away from its bucket; queries widen their
+ * search by that margin and check the exact distance, so no member within
+ * range is ever missed.
+ */
+class SlProximityGrid
+{
+  public:
+    /**
+     * \param cellSize edge of the square cells, in meters
+     * \param refresh period of the refresh of the moving members
+     */
+    SlProximityGrid(double cellSize, Time refresh);
+
+    SlProximityGrid(const SlProximityGrid&) = delete;
+    SlProximityGrid& operator=(const SlProximityGrid&) = delete;
+
+    /**
+     * \param mobility mobility of the new member, whose CourseChange is
+     *        connected
+     * \return the id of the member, assigned sequentially from 0
+     */
+    uint32_t Add(Ptr<MobilityModel> mobility);
+
+    /// \return number of members
+    uint32_t GetN() const;
+
+    /**
+     * Call \p fn (id) for every member within \p radius of \p position.
+     * \param position center of the query
+     * \param radius radius of the query, in meters
+     * \param fn called once per member found
+     */
+    template <typename F>
+    void ForEachWithin(const Vector& position, double radius, F&& fn)
+    {
+        Refresh();
+        double reach = radius + m_maxSpeed * m_refresh.GetSeconds();
+        int64_t x0 = CellCoordinate(position.x - reach);
+        int64_t x1 = CellCoordinate(position.x + reach);
+        int64_t y0 = CellCoordinate(position.y - reach);
+        int64_t y1 = CellCoordinate(position.y + reach);
+        double radius2 = radius * radius;
+        for (int64_t x = x0; x <= x1; ++x)
+        {
+            for (int64_t y = y0; y <= y1; ++y)
+            {
+                auto cell = m_cells.find(CellKey(x, y));
+                if (cell == m_cells.end())
+                {
+                    continue;
+                }
+                for (uint32_t id : cell->second)
+                {
+                    Vector p = m_members[id].mobility->GetPosition();
+                    double dx = p.x - position.x;
+                    double dy = p.y - position.y;
+                    double dz = p.z - position.z;
+                    if (dx * dx + dy * dy + dz * dz <= radius2)
+                    {
+                        fn(id);
+                    }
+                }
+            }
+        }
+    }
+
+  private:
+    /// One member of the grid.
+    struct Member
+    {
+        Ptr<MobilityModel> mobility; //!< position source
+        uint64_t cell;               //!< key of the current bucket
+        uint32_t slot;               //!< index inside the bucket
+        bool moving;                 //!< non-zero velocity at the last course change
+    };
+
+    /// \return the cell coordinate of \p value
+    int64_t CellCoordinate(double value) const
+    {
+        return static_cast<int64_t>(std::floor(value / m_cellSize));
+    }
+
+    /// \return the key of cell (x, y)
+    static uint64_t CellKey(int64_t x, int64_t y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) |
+               static_cast<uint32_t>(y);
+    }
+
+    /// Move \p id to the bucket of its current position.
+    void Place(uint32_t id);
+
+    /// Re-place the moving members if the refresh period has elapsed.
+    void Refresh();
+
+    /**
+     * CourseChange trace sink.
+     * \param grid the grid
+     * \param id the member
+     * \param mobility its mobility model
+     */
+    static void CourseChanged(SlProximityGrid* grid,
+                              uint32_t id,
+                              Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                           //!< edge of the cells
+    Time m_refresh;                                              //!< refresh period
+    Time m_lastRefresh;                                          //!< last refresh
+    double m_maxSpeed{0};                                        //!< largest speed seen
+    std::vector<Member> m_members;                               //!< members, by id
+    std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells; //!< ids per cell
+};
+
+} // namespace ns3
+
+#endif /* SL_PROXIMITY_GRID_H */
@@ -0,0 +1,299 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-proximity-spectrum-channel.h"
+
+#include "sl-spectrum-arena.h"
+
+#include "ns3/abort.h"
+#include "ns3/angles.h"
+#include "ns3/antenna-model.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/phased-array-model.h"
+#include "ns3/phased-array-spectrum-propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-phy.h"
+#include "ns3/spectrum-propagation-loss-model.h"
+#include "ns3/spectrum-signal-parameters.h"
+#include "ns3/trace-source-accessor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlProximitySpectrumChannel");
+
+NS_OBJECT_ENSURE_REGISTERED(SlProximitySpectrumChannel);
+
+TypeId
+SlProximitySpectrumChannel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlProximitySpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<SlProximitySpectrumChannel>()
+            .AddAttribute("Range",
+                          "Interference range: signals are only delivered to the receivers "
+                          "within this distance of the transmitter, in meters",
+                          DoubleValue(500),
+                          MakeDoubleAccessor(&SlProximitySpectrumChannel::m_range),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("GridRefresh",
+                          "Period of the re-bucketing of the moving receivers",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&SlProximitySpectrumChannel::m_gridRefresh),
+                          MakeTimeChecker())
+            .AddTraceSource("SignalDelivered",
+                            "A signal is scheduled for reception by a receiver with mobility",
+                            MakeTraceSourceAccessor(&SlProximitySpectrumChannel::m_signalDelivered),
+                            "ns3::SlProximitySpectrumChannel::SignalDeliveredCallback");
+    return tid;
+}
+
+SlProximitySpectrumChannel::SlProximitySpectrumChannel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlProximitySpectrumChannel::~SlProximitySpectrumChannel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SlProximitySpectrumChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_phyList.clear();
+    m_gridPhys.clear();
+    m_gridIds.clear();
+    m_pending.clear();
+    m_grid.reset();
+    m_spectrumModel = nullptr;
+    SpectrumChannel::DoDispose();
+}
+
+void
+SlProximitySpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    if (std::find(m_phyList.begin(), m_phyList.end(), phy) != m_phyList.end())
+    {
+        return;
+    }
+    m_phyList.push_back(phy);
+    m_pending.push_back(phy);
+}
+
+void
+SlProximitySpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
+{
+    NS_LOG_FUNCTION(this << phy);
+    m_phyList.erase(std::remove(m_phyList.begin(), m_phyList.end(), phy), m_phyList.end());
+    m_pending.erase(std::remove(m_pending.begin(), m_pending.end(), phy), m_pending.end());
+    auto it = m_gridIds.find(PeekPointer(phy));
+    if (it != m_gridIds.end())
+    {
+        // The grid keeps the member; its id no longer maps to a receiver
+        m_gridPhys[it->second] = nullptr;
+        m_gridIds.erase(it);
+    }
+}
+
+void
+SlProximitySpectrumChannel::PlacePending()
+{
+    auto placed = std::remove_if(m_pending.begin(), m_pending.end(), [this](Ptr<SpectrumPhy> phy) {
+        Ptr<MobilityModel> mobility = phy->GetMobility();
+        if (!mobility)
+        {
+            return false;
+        }
+        uint32_t id = m_grid->Add(mobility);
+        m_gridPhys.push_back(phy);
+        m_gridIds[PeekPointer(phy)] = id;
+        return true;
+    });
+    m_pending.erase(placed, m_pending.end());
+}
+
+void
+SlProximitySpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
+{
+    NS_LOG_FUNCTION(this << txParams);
+    NS_ASSERT_MSG(txParams->psd, "NULL txPsd");
+    NS_ASSERT_MSG(txParams->txPhy, "NULL txPhy");
+
+    Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy();
+    txParamsTrace->txPhy = nullptr;
+    m_txSigParamsTrace(txParamsTrace);
+
+    if (!m_spectrumModel)
+    {
+        m_spectrumModel = txParams->psd->GetSpectrumModel();
+    }
+    NS_ABORT_MSG_UNLESS(txParams->psd->GetSpectrumModelUid() == m_spectrumModel->GetUid(),
+                        "SlProximitySpectrumChannel supports a single SpectrumModel");
+
+    if (!m_grid)
+    {
+        m_grid = std::make_unique<SlProximityGrid>(std::max(m_range, 1.0), m_gridRefresh);
+    }
+    if (!m_pending.empty())
+    {
+        PlacePending();
+    }
+
+    Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility();
+    uint64_t delivered = 0;
+    if (!txMobility)
+    {
+        for (const auto& phy : m_phyList)
+        {
+            if (phy != txParams->txPhy)
+            {
+                Propagate(txParams, txMobility, phy);
+                ++delivered;
+            }
+        }
+    }
+    else
+    {
+        m_grid->ForEachWithin(txMobility->GetPosition(), m_range, [&](uint32_t id) {
+            const Ptr<SpectrumPhy>& phy = m_gridPhys[id];
+            if (phy && phy != txParams->txPhy)
+            {
+                Propagate(txParams, txMobility, phy);
+                ++delivered;
+            }
+        });
+        for (const auto& phy : m_pending)
+        {
+            if (phy != txParams->txPhy)
+            {
+                Propagate(txParams, txMobility, phy);
+                ++delivered;
+            }
+        }
+    }
+    m_delivered += delivered;
+    m_outOfRange += std::max<uint64_t>(m_phyList.size(), delivered + 1) - 1 - delivered;
+}
+
+void
+SlProximitySpectrumChannel::Propagate(Ptr<SpectrumSignalParameters> txParams,
+                                      Ptr<MobilityModel> txMobility,
+                                      Ptr<SpectrumPhy> receiver)
+{
+    Ptr<SpectrumSignalParameters> rxParams;
+    {
+        // Only the copy: the loss models below fill long-lived caches
+        SlSpectrumArena::Scope arena;
+        rxParams = txParams->Copy();
+    }
+    Time delay = MicroSeconds(0);
+    Ptr<MobilityModel> rxMobility = receiver->GetMobility();
+
+    if (txMobility && rxMobility)
+    {
+        double pathLossDb = 0;
+        if (rxParams->txAntenna)
+        {
+            Angles txAngles(rxMobility->GetPosition(), txMobility->GetPosition());
+            pathLossDb -= rxParams->txAntenna->GetGainDb(txAngles);
+        }
+        Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(receiver->GetAntenna());
+        if (rxAntenna)
+        {
+            Angles rxAngles(txMobility->GetPosition(), rxMobility->GetPosition());
+            pathLossDb -= rxAntenna->GetGainDb(rxAngles);
+        }
+        if (m_propagationLoss)
+        {
+            pathLossDb -= m_propagationLoss->CalcRxPower(0, txMobility, rxMobility);
+        }
+        m_pathLossTrace(txParams->txPhy, receiver, pathLossDb);
+        if (pathLossDb > m_maxLossDb)
+        {
+            return;
+        }
+        *(rxParams->psd) *= std::pow(10.0, -pathLossDb / 10.0);
+
+        if (m_spectrumPropagationLoss)
+        {
+            rxParams->psd = m_spectrumPropagationLoss->CalcRxPowerSpectralDensity(rxParams,
+                                                                                 txMobility,
+                                                                                 rxMobility);
+        }
+        else if (m_phasedArraySpectrumPropagationLoss)
+        {
+            Ptr<const PhasedArrayModel> txArray =
+                DynamicCast<PhasedArrayModel>(txParams->txPhy->GetAntenna());
+            Ptr<const PhasedArrayModel> rxArray =
+                DynamicCast<PhasedArrayModel>(receiver->GetAntenna());
+            rxParams->psd =
+                m_phasedArraySpectrumPropagationLoss->CalcRxPowerSpectralDensity(rxParams,
+                                                                                 txMobility,
+                                                                                 rxMobility,
+                                                                                 txArray,
+                                                                                 rxArray);
+        }
+
+        if (m_propagationDelay)
+        {
+            delay = m_propagationDelay->GetDelay(txMobility, rxMobility);
+        }
+        m_signalDelivered(txMobility, rxMobility);
+    }
+
+    Ptr<NetDevice> device = receiver->GetDevice();
+    uint32_t context = device ? device->GetNode()->GetId() : 0xffffffff;
+    Simulator::ScheduleWithContext(context,
+                                   delay,
+                                   &SlProximitySpectrumChannel::StartRx,
+                                   this,
+                                   rxParams,
+                                   receiver);
+}
+
+void
+SlProximitySpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params,
+                                    Ptr<SpectrumPhy> receiver)
+{
+    NS_LOG_FUNCTION(this << params);
+    receiver->StartRx(params);
+}
+
+std::size_t
+SlProximitySpectrumChannel::GetNDevices() const
+{
+    return m_phyList.size();
+}
+
+Ptr<NetDevice>
+SlProximitySpectrumChannel::GetDevice(std::size_t i) const
+{
+    return m_phyList.at(i)->GetDevice();
+}
+
+uint64_t
+SlProximitySpectrumChannel::GetDelivered() const
+{
+    return m_delivered;
+}
+
+uint64_t
+SlProximitySpectrumChannel::GetOutOfRange() const
+{
+    return m_outOfRange;
+}
+
+} // namespace ns3
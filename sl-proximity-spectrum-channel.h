@@ -0,0 +1,109 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_PROXIMITY_SPECTRUM_CHANNEL_H
+#define SL_PROXIMITY_SPECTRUM_CHANNEL_H
+
+#include "sl-proximity-grid.h"
+
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/traced-callback.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Spectrum channel delivering signals only to the receivers in range.
+ *
+ * Behaves as MultiModelSpectrumChannel for a single SpectrumModel (the
+ * sidelink BWP), but a transmission is only propagated to the receivers
+ * within Range meters of the transmitter, found with an SlProximityGrid fed
+ * by the CourseChange trace of their mobility. Beyond the interference
+ * range the 3GPP channel and the interference computation of every receiver
+ * cost O(N) per transmission for signals far below the noise floor; with
+ * the grid, a transmission costs O(neighbours).
+ *
+ * Receivers without a mobility model are always delivered to. The
+ * receivers are added to the grid on the first transmission after their
+ * mobility is set, since the PHYs are attached to the channel before the
+ * mobility of the nodes is installed.
+ */
+class SlProximitySpectrumChannel : public SpectrumChannel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlProximitySpectrumChannel();
+    ~SlProximitySpectrumChannel() override;
+
+    // Inherited
+    void AddRx(Ptr<SpectrumPhy> phy) override;
+    void RemoveRx(Ptr<SpectrumPhy> phy);
+    void StartTx(Ptr<SpectrumSignalParameters> params) override;
+    std::size_t GetNDevices() const override;
+    Ptr<NetDevice> GetDevice(std::size_t i) const override;
+
+    /**
+     * TracedCallback signature for the signals delivered to a receiver.
+     * \param [in] tx mobility of the transmitter
+     * \param [in] rx mobility of the receiver
+     */
+    typedef void (*SignalDeliveredCallback)(Ptr<const MobilityModel> tx,
+                                            Ptr<const MobilityModel> rx);
+
+    /// \return signals delivered to a receiver
+    uint64_t GetDelivered() const;
+
+    /// \return signals not delivered because the receiver was out of range
+    uint64_t GetOutOfRange() const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * Deliver a signal to a receiver.
+     * \param params the signal, with the received PSD
+     * \param receiver the receiving PHY
+     */
+    void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
+
+    /**
+     * Compute the received signal and schedule its reception.
+     * \param txParams the transmitted signal
+     * \param txMobility mobility of the transmitter, may be null
+     * \param receiver the receiving PHY
+     */
+    void Propagate(Ptr<SpectrumSignalParameters> txParams,
+                   Ptr<MobilityModel> txMobility,
+                   Ptr<SpectrumPhy> receiver);
+
+    /// Move the receivers whose mobility is now set into the grid.
+    void PlacePending();
+
+    double m_range;                                       //!< interference range, in meters
+    Time m_gridRefresh;                                   //!< refresh period of the grid
+    std::vector<Ptr<SpectrumPhy>> m_phyList;              //!< every receiver
+    Ptr<const SpectrumModel> m_spectrumModel;             //!< model of the signals
+    std::unique_ptr<SlProximityGrid> m_grid;              //!< receivers with mobility
+    std::vector<Ptr<SpectrumPhy>> m_gridPhys;             //!< receiver of every grid id
+    std::unordered_map<SpectrumPhy*, uint32_t> m_gridIds; //!< grid id of every receiver
+    std::vector<Ptr<SpectrumPhy>> m_pending;              //!< receivers without mobility
+    uint64_t m_delivered{0};                              //!< signals delivered
+    uint64_t m_outOfRange{0};                             //!< signals out of range
+    TracedCallback<Ptr<const MobilityModel>, Ptr<const MobilityModel>>
+        m_signalDelivered; //!< signal scheduled for reception, with both mobilities
+};
+
+} // namespace ns3
+
+#endif /* SL_PROXIMITY_SPECTRUM_CHANNEL_H */
@@ -0,0 +1,148 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-region-monitor.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlRegionMonitor");
+
+static const double SPEED_OF_LIGHT = 299792458.0;
+
+SlRegionMonitor::SlRegionMonitor(const std::vector<Vector>& centers, Time sampleInterval)
+    : m_centers(centers),
+      m_sampleInterval(sampleInterval)
+{
+    NS_ABORT_MSG_IF(centers.empty(), "SlRegionMonitor needs at least one region");
+    NS_ABORT_MSG_UNLESS(sampleInterval.IsStrictlyPositive(), "Invalid sample interval");
+}
+
+void
+SlRegionMonitor::Track(const NodeContainer& ues)
+{
+    for (auto it = ues.Begin(); it != ues.End(); ++it)
+    {
+        Ptr<MobilityModel> mobility = (*it)->GetObject<MobilityModel>();
+        NS_ABORT_MSG_UNLESS(mobility, "UE " << (*it)->GetId() << " without mobility");
+        m_index[PeekPointer(mobility)] = m_ues.size();
+        m_ues.push_back(mobility);
+        m_region.push_back(RegionOf(mobility->GetPosition()));
+    }
+    Simulator::ScheduleNow(&SlRegionMonitor::Sample, this);
+}
+
+uint32_t
+SlRegionMonitor::RegionOf(const Vector& position) const
+{
+    uint32_t region = 0;
+    double best = std::numeric_limits<double>::max();
+    for (uint32_t i = 0; i < m_centers.size(); ++i)
+    {
+        double dx = position.x - m_centers[i].x;
+        double dy = position.y - m_centers[i].y;
+        if (dx * dx + dy * dy < best)
+        {
+            best = dx * dx + dy * dy;
+            region = i;
+        }
+    }
+    return region;
+}
+
+void
+SlRegionMonitor::Sample()
+{
+    std::vector<uint32_t> counts(m_centers.size(), 0);
+    for (size_t i = 0; i < m_ues.size(); ++i)
+    {
+        uint32_t region = RegionOf(m_ues[i]->GetPosition());
+        if (region != m_region[i])
+        {
+            ++m_migrations;
+            m_region[i] = region;
+        }
+        ++counts[region];
+    }
+    m_samples.push_back(counts);
+    Simulator::Schedule(m_sampleInterval, &SlRegionMonitor::Sample, this);
+}
+
+void
+SlRegionMonitor::SignalDelivered(SlRegionMonitor* monitor,
+                                 Ptr<const MobilityModel> tx,
+                                 Ptr<const MobilityModel> rx)
+{
+    auto txUe = monitor->m_index.find(PeekPointer(tx));
+    auto rxUe = monitor->m_index.find(PeekPointer(rx));
+    if (txUe == monitor->m_index.end() || rxUe == monitor->m_index.end())
+    {
+        return;
+    }
+    if (monitor->m_region[txUe->second] == monitor->m_region[rxUe->second])
+    {
+        ++monitor->m_intra;
+        return;
+    }
+    ++monitor->m_cross;
+    double distance = tx->GetDistanceFrom(rx);
+    if (monitor->m_minCrossDistance < 0 || distance < monitor->m_minCrossDistance)
+    {
+        monitor->m_minCrossDistance = distance;
+    }
+}
+
+void
+SlRegionMonitor::Write(const std::string& prefix) const
+{
+    // Speedup bound of every sample: the busiest partition sets the pace
+    double speedup = 0;
+    for (const auto& counts : m_samples)
+    {
+        uint32_t busiest = *std::max_element(counts.begin(), counts.end());
+        speedup += busiest ? static_cast<double>(m_ues.size()) / busiest : m_centers.size();
+    }
+    speedup = m_samples.empty() ? 0 : speedup / m_samples.size();
+    uint64_t signals = m_intra + m_cross;
+
+    std::ofstream summary(prefix + "-regions-summary.csv");
+    summary << "metric,value\n"
+            << "regions," << m_centers.size() << "\n"
+            << "ues," << m_ues.size() << "\n"
+            << "samples," << m_samples.size() << "\n"
+            << "migrations," << m_migrations << "\n"
+            << "meanSpeedupBound," << speedup << "\n"
+            << "intraSignals," << m_intra << "\n"
+            << "crossSignals," << m_cross << "\n"
+            << "crossFraction," << (signals ? static_cast<double>(m_cross) / signals : 0) << "\n"
+            << "minCrossDistance," << m_minCrossDistance << "\n"
+            << "lookahead,"
+            << (m_minCrossDistance < 0 ? -1 : m_minCrossDistance / SPEED_OF_LIGHT) << "\n";
+
+    std::ofstream time(prefix + "-regions-time.csv");
+    time << "time";
+    for (size_t r = 0; r < m_centers.size(); ++r)
+    {
+        time << ",region" << r;
+    }
+    time << "\n";
+    for (size_t i = 0; i < m_samples.size(); ++i)
+    {
+        time << m_sampleInterval.GetSeconds() * i;
+        for (uint32_t count : m_samples[i])
+        {
+            time << "," << count;
+        }
+        time << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,89 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_REGION_MONITOR_H
+#define SL_REGION_MONITOR_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Feasibility of a parallel, partitioned-by-region run.
+ *
+ * The UEs are assigned to the region of their nearest center (the gNBs),
+ * re-assigned at every sample as the vehicles move. The monitor records:
+ *
+ * - the UEs of every region at every sample, and the migrations between
+ *   regions, i.e. the load balance a partitioned run would get;
+ * - the sidelink signals delivered inside a region and across regions,
+ *   and the shortest cross-region propagation delay, which bounds the
+ *   lookahead of a conservative synchronization between partitions.
+ *
+ * The signals come from the SignalDelivered trace of
+ * SlProximitySpectrumChannel, and are classified by the regions the UEs
+ * were assigned at the last sample, as a partitioned run would route them.
+ * Signals of a node that is not tracked are ignored.
+ */
+class SlRegionMonitor
+{
+  public:
+    /**
+     * \param centers center of every region
+     * \param sampleInterval time between two assignments of the UEs
+     */
+    SlRegionMonitor(const std::vector<Vector>& centers, Time sampleInterval);
+
+    /**
+     * Assign \p ues now and at every sample.
+     * \param ues the UEs, with their mobility installed
+     */
+    void Track(const NodeContainer& ues);
+
+    /**
+     * SignalDelivered trace sink.
+     * \param monitor the monitor
+     * \param tx mobility of the transmitter
+     * \param rx mobility of the receiver
+     */
+    static void SignalDelivered(SlRegionMonitor* monitor,
+                                Ptr<const MobilityModel> tx,
+                                Ptr<const MobilityModel> rx);
+
+    /**
+     * Write <prefix>-regions-summary.csv and <prefix>-regions-time.csv.
+     * \param prefix output path without suffix
+     */
+    void Write(const std::string& prefix) const;
+
+  private:
+    /// \return region of \p position
+    uint32_t RegionOf(const Vector& position) const;
+
+    /// Re-assign the UEs and record the UEs per region.
+    void Sample();
+
+    std::vector<Vector> m_centers;                              //!< center of every region
+    Time m_sampleInterval;                                      //!< time between samples
+    std::vector<Ptr<MobilityModel>> m_ues;                      //!< tracked UEs
+    std::unordered_map<const MobilityModel*, uint32_t> m_index; //!< UE of every mobility
+    std::vector<uint32_t> m_region;                             //!< region of every UE
+    std::vector<std::vector<uint32_t>> m_samples;               //!< UEs per region, per sample
+    uint64_t m_migrations{0};                                   //!< UEs that changed region
+    uint64_t m_intra{0};                                        //!< signals inside a region
+    uint64_t m_cross{0};                                        //!< signals across regions
+    double m_minCrossDistance{-1};                              //!< shortest cross-region link [m]
+};
+
+} // namespace ns3
+
+#endif /* SL_REGION_MONITOR_H */
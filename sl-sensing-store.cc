@@ -0,0 +1,308 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-sensing-store.h"
+
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/nr-ue-net-device.h"
+#include "ns3/nstime.h"
+#include "ns3/object-vector.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlSensingStore");
+
+NS_OBJECT_ENSURE_REGISTERED(SlSensingScheduler);
+
+std::vector<SlSensingScheduler*> SlSensingScheduler::s_pending;
+uint64_t SlSensingScheduler::s_sensed = 0;
+uint64_t SlSensingScheduler::s_candidates = 0;
+uint64_t SlSensingScheduler::s_excluded = 0;
+uint64_t SlSensingScheduler::s_fallbacks = 0;
+uint64_t SlSensingScheduler::s_dropped = 0;
+
+/// Largest retransmission gap of an SCI, in slots
+static constexpr uint32_t MAX_GAP = 31;
+
+/// \return the bitset of \p length subchannels from \p start
+static uint64_t
+SubchannelMask(uint32_t start, uint32_t length)
+{
+    if (start >= 64 || length == 0)
+    {
+        return 0;
+    }
+    uint64_t bits = length >= 64 ? ~uint64_t(0) : (uint64_t(1) << length) - 1;
+    return bits << start;
+}
+
+SlSensingStore::SlSensingStore(uint32_t horizon)
+{
+    uint64_t size = 1;
+    while (size < horizon)
+    {
+        size <<= 1;
+    }
+    m_reserved.assign(size, 0);
+    m_slot.assign(size, ~uint64_t(0));
+    m_mask = size - 1;
+}
+
+bool
+SlSensingStore::Insert(uint64_t slot, uint64_t now, uint32_t sbChStart, uint32_t sbChLength)
+{
+    if (slot < now || slot - now > m_mask)
+    {
+        return false;
+    }
+    uint64_t i = slot & m_mask;
+    if (m_slot[i] != slot)
+    {
+        m_slot[i] = slot;
+        m_reserved[i] = 0;
+    }
+    m_reserved[i] |= SubchannelMask(sbChStart, sbChLength);
+    return true;
+}
+
+uint64_t
+SlSensingStore::GetReserved(uint64_t slot) const
+{
+    uint64_t i = slot & m_mask;
+    return m_slot[i] == slot ? m_reserved[i] : 0;
+}
+
+uint64_t
+SlSensingStore::GetFreeStarts(uint64_t slot, uint32_t length, uint32_t total) const
+{
+    uint64_t free = ~GetReserved(slot) & SubchannelMask(0, total);
+    uint64_t starts = free;
+    for (uint32_t k = 1; k < length && starts != 0; ++k)
+    {
+        starts &= free >> k;
+    }
+    return starts;
+}
+
+TypeId
+SlSensingScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlSensingScheduler")
+            .SetParent<NrSlUeMacSchedulerSimple>()
+            .AddConstructor<SlSensingScheduler>()
+            .AddAttribute("SinrThreshold",
+                          "Smallest average SINR, in dB, of a PSCCH whose reservations are "
+                          "excluded; the default excludes every decoded PSCCH",
+                          DoubleValue(-1000.0),
+                          MakeDoubleAccessor(&SlSensingScheduler::m_sinrThreshold),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MinSubchannels",
+                          "Subchannels, from the first, that must be free in a candidate slot",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&SlSensingScheduler::m_minSubchannels),
+                          MakeUintegerChecker<uint32_t>(1, 64))
+            .AddAttribute("MinCandidateRatio",
+                          "Fraction of the candidate slots that must be left by the "
+                          "exclusion; below it no slot is excluded",
+                          DoubleValue(0.2),
+                          MakeDoubleAccessor(&SlSensingScheduler::m_minCandidateRatio),
+                          MakeDoubleChecker<double>(0.0, 1.0))
+            .AddAttribute("Horizon",
+                          "Slots ahead of the current one whose reservations are kept; "
+                          "Connect raises it to cover the ReservationPeriod of the MAC",
+                          UintegerValue(2048),
+                          MakeUintegerAccessor(&SlSensingScheduler::m_horizon),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+SlSensingScheduler::SlSensingScheduler()
+{
+    NS_LOG_FUNCTION(this);
+    s_pending.push_back(this);
+}
+
+SlSensingScheduler::~SlSensingScheduler()
+{
+    NS_LOG_FUNCTION(this);
+    s_pending.erase(std::remove(s_pending.begin(), s_pending.end(), this), s_pending.end());
+}
+
+void
+SlSensingScheduler::Connect(const NetDeviceContainer& devices)
+{
+    NS_ABORT_MSG_UNLESS(s_pending.size() == devices.GetN(),
+                        "Created " << s_pending.size() << " SlSensingScheduler for "
+                                   << devices.GetN() << " devices");
+    for (uint32_t i = 0; i < devices.GetN(); ++i)
+    {
+        Ptr<NrUeNetDevice> device = DynamicCast<NrUeNetDevice>(devices.Get(i));
+        NS_ABORT_MSG_UNLESS(device, "SlSensingScheduler needs NrUeNetDevice");
+        SlSensingScheduler* scheduler = s_pending[i];
+        scheduler->m_numerology = device->GetPhy(0)->GetNumerology();
+        // A reservation lands one period, plus a gap, after its PSCCH
+        TimeValue period;
+        device->GetMac(0)->GetAttribute("ReservationPeriod", period);
+        uint64_t needed = (uint64_t(period.Get().GetMilliSeconds()) << scheduler->m_numerology) +
+                          MAX_GAP + 1;
+        scheduler->m_horizon = std::max<uint64_t>(scheduler->m_horizon, needed);
+        scheduler->m_store = SlSensingStore(scheduler->m_horizon);
+        for (uint32_t cc = 0; cc < device->GetCcMapSize(); ++cc)
+        {
+            device->GetMac(cc)->TraceConnectWithoutContext(
+                "SlPscchScheduling",
+                MakeBoundCallback(&SlSensingScheduler::Sent, scheduler));
+            ObjectVectorValue spectrumPhys;
+            device->GetPhy(cc)->GetAttribute("NrSpectrumPhyList", spectrumPhys);
+            for (auto phy = spectrumPhys.Begin(); phy != spectrumPhys.End(); ++phy)
+            {
+                phy->second->TraceConnectWithoutContext(
+                    "RxPscchTraceUe",
+                    MakeBoundCallback(&SlSensingScheduler::Sensed, scheduler));
+            }
+        }
+    }
+    s_pending.clear();
+}
+
+void
+SlSensingScheduler::Sensed(SlSensingScheduler* scheduler, const SlRxCtrlPacketTraceParams params)
+{
+    if (params.m_corrupt || params.m_sinr < scheduler->m_sinrThreshold)
+    {
+        return;
+    }
+    ++s_sensed;
+    scheduler->m_totalSubchannels = params.m_totalSubChannels;
+    std::vector<uint32_t> gaps;
+    if (params.m_maxNumPerReserve > 1)
+    {
+        gaps.push_back(params.m_gapReTx1);
+    }
+    if (params.m_maxNumPerReserve > 2)
+    {
+        gaps.push_back(params.m_gapReTx2);
+    }
+    scheduler->Reserve(
+        SfnSf(params.m_frameNum, params.m_subframeNum, params.m_slotNum, scheduler->m_numerology),
+        params.m_slResourceReservePeriod,
+        params.m_indexStartSubChannel,
+        params.m_lengthSubChannel,
+        gaps);
+}
+
+void
+SlSensingScheduler::Sent(SlSensingScheduler* scheduler, const SlPscchUeMacStatParameters params)
+{
+    // Half duplex: the UE cannot receive in the slots of its next reservation
+    scheduler->m_totalSubchannels = params.totalSubChannels;
+    scheduler->Reserve(
+        SfnSf(params.frameNum, params.subframeNum, params.slotNum, scheduler->m_numerology),
+        params.slResourceReservePeriod,
+        0,
+        64,
+        {});
+}
+
+void
+SlSensingScheduler::Reserve(const SfnSf& sfn,
+                            uint16_t period,
+                            uint32_t sbChStart,
+                            uint32_t sbChLength,
+                            const std::vector<uint32_t>& gaps)
+{
+    uint64_t now = sfn.Normalize();
+    uint64_t periodSlots = uint64_t(period) << m_numerology;
+    auto insert = [&](uint64_t slot) {
+        if (!m_store.Insert(slot, now, sbChStart, sbChLength))
+        {
+            ++s_dropped;
+            NS_LOG_WARN("Reservation " << slot - now << " slots ahead is beyond the horizon of "
+                                       << m_horizon << " slots; raise Horizon");
+        }
+    };
+    for (uint32_t gap : gaps)
+    {
+        if (gap > 0)
+        {
+            insert(now + gap);
+        }
+    }
+    if (periodSlots == 0)
+    {
+        return;
+    }
+    insert(now + periodSlots);
+    for (uint32_t gap : gaps)
+    {
+        if (gap > 0)
+        {
+            insert(now + periodSlots + gap);
+        }
+    }
+}
+
+bool
+SlSensingScheduler::DoNrSlAllocation(
+    const std::list<NrSlUeMacSchedSapProvider::NrSlSlotInfo>& txOpps,
+    const std::shared_ptr<NrSlUeMacSchedulerDstInfo>& dstInfo,
+    std::set<NrSlSlotAlloc>& slotAllocList)
+{
+    std::list<NrSlUeMacSchedSapProvider::NrSlSlotInfo> kept;
+    for (const auto& opp : txOpps)
+    {
+        uint64_t starts =
+            m_store.GetFreeStarts(opp.sfn.Normalize(), m_minSubchannels, m_totalSubchannels);
+        if (starts & 1)
+        {
+            kept.push_back(opp);
+        }
+    }
+    s_candidates += txOpps.size();
+    if (kept.size() < m_minCandidateRatio * txOpps.size())
+    {
+        ++s_fallbacks;
+        return NrSlUeMacSchedulerSimple::DoNrSlAllocation(txOpps, dstInfo, slotAllocList);
+    }
+    s_excluded += txOpps.size() - kept.size();
+    return NrSlUeMacSchedulerSimple::DoNrSlAllocation(kept, dstInfo, slotAllocList);
+}
+
+uint64_t
+SlSensingScheduler::GetSensed()
+{
+    return s_sensed;
+}
+
+uint64_t
+SlSensingScheduler::GetCandidates()
+{
+    return s_candidates;
+}
+
+uint64_t
+SlSensingScheduler::GetExcluded()
+{
+    return s_excluded;
+}
+
+uint64_t
+SlSensingScheduler::GetFallbacks()
+{
+    return s_fallbacks;
+}
+
+uint64_t
+SlSensingScheduler::GetDropped()
+{
+    return s_dropped;
+}
+
+} // namespace ns3
@@ -0,0 +1,178 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_SENSING_STORE_H
+#define SL_SENSING_STORE_H
+
+#include "ns3/net-device-container.h"
+#include "ns3/nr-sl-phy-mac-common.h"
+#include "ns3/nr-sl-ue-mac-scheduler-simple.h"
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Sidelink resources reserved in the coming slots, as seen by one UE.
+ *
+ * A ring of slots, each holding the bitset of its reserved subchannels and
+ * the absolute slot it belongs to. Insert and lookup are O(1); entries of
+ * an older lap of the ring are recognized by their slot and read as free,
+ * so nothing is ever cleared. Reservations farther than the ring are
+ * dropped. The pool may have up to 64 subchannels.
+ */
+class SlSensingStore
+{
+  public:
+    /**
+     * \param horizon slots ahead of the latest reservation that are kept,
+     * rounded up to a power of two
+     */
+    explicit SlSensingStore(uint32_t horizon = 2048);
+
+    /**
+     * Mark subchannels as reserved.
+     * \param slot absolute slot of the reservation
+     * \param now absolute current slot
+     * \param sbChStart first reserved subchannel
+     * \param sbChLength number of reserved subchannels
+     * \return false if \p slot is beyond the horizon and was dropped
+     */
+    bool Insert(uint64_t slot, uint64_t now, uint32_t sbChStart, uint32_t sbChLength);
+
+    /**
+     * \param slot absolute slot
+     * \return the bitset of the reserved subchannels of \p slot
+     */
+    uint64_t GetReserved(uint64_t slot) const;
+
+    /**
+     * Placements of \p length contiguous subchannels that do not overlap a
+     * reservation, computed with word operations on the bitset.
+     * \param slot absolute slot
+     * \param length subchannels of the placement
+     * \param total subchannels of the pool
+     * \return bit i set if subchannels [i, i + length) are free
+     */
+    uint64_t GetFreeStarts(uint64_t slot, uint32_t length, uint32_t total) const;
+
+  private:
+    std::vector<uint64_t> m_reserved; //!< reserved subchannels of every slot
+    std::vector<uint64_t> m_slot;     //!< absolute slot of every entry
+    uint64_t m_mask;                  //!< ring size - 1
+};
+
+/**
+ * \brief NrSlUeMacSchedulerSimple excluding the sensed reservations from
+ * the candidate slots.
+ *
+ * The sensing of the NrUeMac keeps every received SCI in lists that are
+ * scanned for each candidate, which is why exp01 runs with EnableSensing
+ * off. This scheduler keeps the MAC sensing off and does the exclusion
+ * itself: every decoded PSCCH of another UE (RxPscchTraceUe), with a SINR
+ * of at least SinrThreshold, reserves its subchannels one reservation
+ * period later, as do its retransmissions; every PSCCH sent by the UE
+ * reserves the whole slot, for the half-duplex exclusion. The reservations
+ * go to an SlSensingStore, and a candidate slot is dropped when the first
+ * MinSubchannels subchannels, where NrSlUeMacSchedulerSimple places every
+ * transport block, are reserved. When fewer than MinCandidateRatio of the
+ * candidates are left, all of them are used, as 3GPP would raise the RSRP
+ * threshold until enough are.
+ *
+ * The counters are shared by all the instances.
+ */
+class SlSensingScheduler : public NrSlUeMacSchedulerSimple
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlSensingScheduler();
+    ~SlSensingScheduler() override;
+
+    /**
+     * Feed the schedulers created since the last call with the PSCCH
+     * traces of \p devices, and raise their Horizon to cover the
+     * ReservationPeriod of the MAC. NrSlHelper::PrepareUeForSidelink
+     * creates one scheduler per device, in device order; the i-th
+     * scheduler is given to the i-th device.
+     * \param devices the devices given to PrepareUeForSidelink
+     */
+    static void Connect(const NetDeviceContainer& devices);
+
+    /// \return PSCCH receptions stored as reservations
+    static uint64_t GetSensed();
+
+    /// \return candidate slots given to the schedulers
+    static uint64_t GetCandidates();
+
+    /// \return candidate slots excluded
+    static uint64_t GetExcluded();
+
+    /// \return selections that kept every candidate, too few being left
+    static uint64_t GetFallbacks();
+
+    /// \return reservations dropped, being beyond the horizon of the store
+    static uint64_t GetDropped();
+
+  protected:
+    bool DoNrSlAllocation(const std::list<NrSlUeMacSchedSapProvider::NrSlSlotInfo>& txOpps,
+                          const std::shared_ptr<NrSlUeMacSchedulerDstInfo>& dstInfo,
+                          std::set<NrSlSlotAlloc>& slotAllocList) override;
+
+  private:
+    /**
+     * RxPscchTraceUe sink.
+     * \param scheduler the scheduler of the receiving UE
+     * \param params the reception
+     */
+    static void Sensed(SlSensingScheduler* scheduler, const SlRxCtrlPacketTraceParams params);
+
+    /**
+     * SlPscchScheduling sink.
+     * \param scheduler the scheduler of the sending UE
+     * \param params the transmission
+     */
+    static void Sent(SlSensingScheduler* scheduler, const SlPscchUeMacStatParameters params);
+
+    /**
+     * Store the reservations of a PSCCH.
+     * \param sfn slot of the PSCCH
+     * \param period reservation period, in ms
+     * \param sbChStart first subchannel
+     * \param sbChLength number of subchannels
+     * \param gaps gaps of the retransmissions, in slots, 0 when unused
+     */
+    void Reserve(const SfnSf& sfn,
+                 uint16_t period,
+                 uint32_t sbChStart,
+                 uint32_t sbChLength,
+                 const std::vector<uint32_t>& gaps);
+
+    double m_sinrThreshold;          //!< smallest SINR of a sensed PSCCH [dB]
+    uint32_t m_minSubchannels;       //!< subchannels that must be free
+    double m_minCandidateRatio;      //!< fraction of candidates that must be left
+    uint32_t m_horizon;              //!< slots of the store
+    uint8_t m_numerology{0};         //!< numerology of the sidelink BWP
+    uint32_t m_totalSubchannels{64}; //!< subchannels of the pool
+    SlSensingStore m_store;          //!< reservations seen by the UE
+
+    static std::vector<SlSensingScheduler*> s_pending; //!< created, not connected
+    static uint64_t s_sensed;                          //!< receptions stored
+    static uint64_t s_candidates;                      //!< candidate slots
+    static uint64_t s_excluded;                        //!< candidate slots excluded
+    static uint64_t s_fallbacks;                       //!< selections without exclusion
+    static uint64_t s_dropped;                         //!< reservations beyond the horizon
+};
+
+} // namespace ns3
+
+#endif /* SL_SENSING_STORE_H */
@@ -0,0 +1,161 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-spectrum-arena.h"
+
+#include "ns3/abort.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <sys/mman.h>
+
+namespace
+{
+
+constexpr std::size_t CLASS_BYTES = 64; //!< granularity of the size classes
+constexpr std::size_t CLASSES = 64;     //!< size classes, up to 4 KiB
+constexpr std::size_t RUN_BITS = 16;    //!< log2 of the runs carved for a class
+
+// Plain data only: operator new may run before any constructor
+char* g_base = nullptr;                     //!< the reserved range
+std::size_t g_reserve = 0;                  //!< size of the range
+std::size_t g_used = 0;                     //!< bytes of the range given to runs
+uint8_t* g_runClass = nullptr;              //!< size class of every run
+void* g_free[CLASSES] = {};                 //!< free list of every class
+char* g_runNext[CLASSES] = {};              //!< next block of the current run of a class
+char* g_runEnd[CLASSES] = {};               //!< end of the current run of a class
+std::atomic_flag g_lock = ATOMIC_FLAG_INIT; //!< blocks may be freed by other threads
+uint64_t g_carved = 0;                      //!< blocks carved
+uint64_t g_recycled = 0;                    //!< allocations served by a freed block
+std::atomic<uint64_t> g_heap{0};            //!< allocations in a scope sent to the heap
+thread_local uint32_t t_depth = 0;          //!< scopes alive on this thread
+
+/// Holds g_lock.
+struct Lock
+{
+    Lock()
+    {
+        while (g_lock.test_and_set(std::memory_order_acquire))
+        {
+        }
+    }
+
+    ~Lock()
+    {
+        g_lock.clear(std::memory_order_release);
+    }
+};
+
+} // namespace
+
+namespace ns3
+{
+
+SlSpectrumArena::Scope::Scope()
+{
+    ++t_depth;
+}
+
+SlSpectrumArena::Scope::~Scope()
+{
+    --t_depth;
+}
+
+void
+SlSpectrumArena::Enable(std::size_t reserve)
+{
+    NS_ABORT_MSG_IF(g_base, "SlSpectrumArena already enabled");
+    reserve = (reserve >> RUN_BITS) << RUN_BITS;
+    void* base = mmap(nullptr,
+                      reserve,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                      -1,
+                      0);
+    NS_ABORT_MSG_IF(base == MAP_FAILED, "Cannot reserve " << reserve << " bytes for the arena");
+    g_runClass = static_cast<uint8_t*>(std::calloc(reserve >> RUN_BITS, 1));
+    g_reserve = reserve;
+    g_base = static_cast<char*>(base);
+}
+
+bool
+SlSpectrumArena::IsEnabled()
+{
+    return g_base != nullptr;
+}
+
+void*
+SlSpectrumArena::Allocate(std::size_t size)
+{
+    if (t_depth == 0 || !g_base)
+    {
+        return nullptr;
+    }
+    if (size > CLASS_BYTES * CLASSES)
+    {
+        g_heap.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    std::size_t cls = size ? (size - 1) / CLASS_BYTES : 0;
+    std::size_t bytes = (cls + 1) * CLASS_BYTES;
+    Lock lock;
+    if (void* p = g_free[cls])
+    {
+        g_free[cls] = *static_cast<void**>(p);
+        ++g_recycled;
+        return p;
+    }
+    if (!g_runNext[cls] || std::size_t(g_runEnd[cls] - g_runNext[cls]) < bytes)
+    {
+        std::size_t run = std::size_t(1) << RUN_BITS;
+        if (g_used + run > g_reserve)
+        {
+            g_heap.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        g_runClass[g_used >> RUN_BITS] = cls;
+        g_runNext[cls] = g_base + g_used;
+        g_runEnd[cls] = g_runNext[cls] + run;
+        g_used += run;
+    }
+    void* p = g_runNext[cls];
+    g_runNext[cls] += bytes;
+    ++g_carved;
+    return p;
+}
+
+bool
+SlSpectrumArena::Free(void* p)
+{
+    auto address = reinterpret_cast<uintptr_t>(p);
+    auto base = reinterpret_cast<uintptr_t>(g_base);
+    if (!g_base || address < base || address >= base + g_reserve)
+    {
+        return false;
+    }
+    std::size_t cls = g_runClass[(address - base) >> RUN_BITS];
+    Lock lock;
+    *static_cast<void**>(p) = g_free[cls];
+    g_free[cls] = p;
+    return true;
+}
+
+uint64_t
+SlSpectrumArena::GetCarved()
+{
+    return g_carved;
+}
+
+uint64_t
+SlSpectrumArena::GetRecycled()
+{
+    return g_recycled;
+}
+
+uint64_t
+SlSpectrumArena::GetHeapAllocations()
+{
+    return g_heap.load(std::memory_order_relaxed);
+}
+
+} // namespace ns3
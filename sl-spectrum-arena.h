@@ -0,0 +1,77 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_SPECTRUM_ARENA_H
+#define SL_SPECTRUM_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * \brief Free-list recycler for the signal copies of the proximity channel.
+ *
+ * SlProximitySpectrumChannel copies the signal parameters, and with them
+ * the PSD, once per receiver. While a Scope is alive on the simulation
+ * thread, the global operator new of this program (sl-heap-hooks.cc,
+ * built with SL_HEAP_HOOKS) serves requests of up to 4 KiB from this
+ * arena instead of malloc: blocks of 64-byte size classes carved from one
+ * reserved address range, which operator delete recognizes by address and
+ * puts back on the free list of their class. A copy freed after its
+ * reception is reused by the next one.
+ *
+ * Only the copy is in scope. The loss models, the interference and SINR
+ * computation of the PHY and anything over 4 KiB still use the heap.
+ */
+class SlSpectrumArena
+{
+  public:
+    /// Serves the allocations of the current thread while alive.
+    class Scope
+    {
+      public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * Reserve the address range of the arena; memory is only committed as
+     * blocks are carved.
+     * \param reserve size of the range, in bytes
+     */
+    static void Enable(std::size_t reserve = std::size_t(1) << 30);
+
+    /// \return true once Enable() was called
+    static bool IsEnabled();
+
+    /**
+     * \param size bytes requested
+     * \return a block of the arena, or nullptr outside a Scope or when the
+     * request does not fit
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * \param p a pointer given by operator new
+     * \return true if \p p was an arena block, now free
+     */
+    static bool Free(void* p);
+
+    /// \return blocks carved from the range
+    static uint64_t GetCarved();
+
+    /// \return allocations served by a freed block
+    static uint64_t GetRecycled();
+
+    /// \return allocations inside a Scope that went to the heap
+    static uint64_t GetHeapAllocations();
+};
+
+} // namespace ns3
+
+#endif /* SL_SPECTRUM_ARENA_H */
@@ -0,0 +1,89 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-trace-wiring.h"
+
+#include "ns3/log.h"
+#include "ns3/nr-ue-mac.h"
+#include "ns3/nr-ue-net-device.h"
+#include "ns3/nr-ue-phy.h"
+#include "ns3/object-vector.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlTraceWiring");
+
+SlTraceWiring::SlTraceWiring(SlRecordSink<SlPscchUeMacStatParameters>* pscchTx,
+                             SlRecordSink<SlPsschUeMacStatParameters>* psschTx,
+                             SlRecordSink<SlRxCtrlPacketTraceParams>* pscchRx,
+                             SlRecordSink<SlRxDataPacketTraceParams>* psschRx,
+                             uint32_t capacity)
+    : m_pscchTx(pscchTx, capacity),
+      m_psschTx(psschTx, capacity),
+      m_pscchRx(pscchRx, capacity),
+      m_psschRx(psschRx, capacity)
+{
+}
+
+void
+SlTraceWiring::Connect(const NetDeviceContainer& devices)
+{
+    for (auto it = devices.Begin(); it != devices.End(); ++it)
+    {
+        Ptr<NrUeNetDevice> device = DynamicCast<NrUeNetDevice>(*it);
+        if (!device)
+        {
+            continue;
+        }
+        auto pscchTx = m_pscchTx.AddShard();
+        auto psschTx = m_psschTx.AddShard();
+        auto pscchRx = m_pscchRx.AddShard();
+        auto psschRx = m_psschRx.AddShard();
+        uint32_t connected = 0;
+        for (uint32_t cc = 0; cc < device->GetCcMapSize(); ++cc)
+        {
+            Ptr<NrUeMac> mac = device->GetMac(cc);
+            connected += mac->TraceConnectWithoutContext(
+                "SlPscchScheduling",
+                MakeBoundCallback(&SlTraceShards<SlPscchUeMacStatParameters>::Push, pscchTx));
+            connected += mac->TraceConnectWithoutContext(
+                "SlPsschScheduling",
+                MakeBoundCallback(&SlTraceShards<SlPsschUeMacStatParameters>::Push, psschTx));
+
+            ObjectVectorValue spectrumPhys;
+            device->GetPhy(cc)->GetAttribute("NrSpectrumPhyList", spectrumPhys);
+            for (auto phy = spectrumPhys.Begin(); phy != spectrumPhys.End(); ++phy)
+            {
+                connected += phy->second->TraceConnectWithoutContext(
+                    "RxPscchTraceUe",
+                    MakeBoundCallback(&SlTraceShards<SlRxCtrlPacketTraceParams>::Push, pscchRx));
+                connected += phy->second->TraceConnectWithoutContext(
+                    "RxPsschTraceUe",
+                    MakeBoundCallback(&SlTraceShards<SlRxDataPacketTraceParams>::Push, psschRx));
+            }
+        }
+        NS_LOG_INFO("Node " << device->GetNode()->GetId() << ": " << connected
+                            << " sidelink traces connected");
+    }
+}
+
+void
+SlTraceWiring::Flush()
+{
+    m_pscchTx.Flush();
+    m_psschTx.Flush();
+    m_pscchRx.Flush();
+    m_psschRx.Flush();
+}
+
+void
+SlTraceWiring::Discard()
+{
+    m_pscchTx.Discard();
+    m_psschTx.Discard();
+    m_pscchRx.Discard();
+    m_psschRx.Discard();
+}
+
+} // namespace ns3
@@ -0,0 +1,151 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_TRACE_WIRING_H
+#define SL_TRACE_WIRING_H
+
+#include "sl-output-records.h"
+
+#include "ns3/net-device-container.h"
+
+#include <memory>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Records of one trace source, buffered per node.
+ *
+ * Every node owns a shard; its trace callbacks are bound to the shard and
+ * only append to a vector. A shard is handed to the sink when it holds
+ * \p capacity records, and on Flush(). Rows of different nodes are
+ * therefore not written in time order; use the time columns to sort them.
+ */
+template <typename Record>
+class SlTraceShards
+{
+  public:
+    /// Buffer of one node.
+    struct Shard
+    {
+        SlTraceShards* owner;        //!< shards of the trace source
+        std::vector<Record> records; //!< records not saved yet
+    };
+
+    /**
+     * \param sink destination of the records
+     * \param capacity records buffered per node
+     */
+    SlTraceShards(SlRecordSink<Record>* sink, uint32_t capacity)
+        : m_sink(sink),
+          m_capacity(capacity == 0 ? 1 : capacity)
+    {
+    }
+
+    /// \return a new shard, valid as long as this object
+    Shard* AddShard()
+    {
+        m_shards.push_back(std::make_unique<Shard>());
+        Shard* shard = m_shards.back().get();
+        shard->owner = this;
+        shard->records.reserve(m_capacity);
+        return shard;
+    }
+
+    /**
+     * Trace sink, bound to a shard.
+     * \param shard the shard of the node
+     * \param record traced record
+     */
+    static void Push(Shard* shard, const Record record)
+    {
+        shard->records.push_back(record);
+        if (shard->records.size() >= shard->owner->m_capacity)
+        {
+            shard->owner->Save(*shard);
+        }
+    }
+
+    /// Hand every buffered record to the sink.
+    void Flush()
+    {
+        for (auto& shard : m_shards)
+        {
+            Save(*shard);
+        }
+    }
+
+    /// Drop every buffered record.
+    void Discard()
+    {
+        for (auto& shard : m_shards)
+        {
+            shard->records.clear();
+        }
+    }
+
+  private:
+    /// Save and clear the records of \p shard.
+    void Save(Shard& shard)
+    {
+        for (const auto& record : shard.records)
+        {
+            m_sink->Save(record);
+        }
+        shard.records.clear();
+    }
+
+    SlRecordSink<Record>* m_sink;                 //!< destination of the records
+    uint32_t m_capacity;                          //!< records buffered per node
+    std::vector<std::unique_ptr<Shard>> m_shards; //!< one per node
+};
+
+/**
+ * \brief Connects the sidelink MAC and PHY traces of the UE devices.
+ *
+ * Equivalent to the Config::ConnectWithoutContext calls on
+ * "/NodeList/.../NrUeMac/SlPscchScheduling"-style wildcard paths, but every
+ * NrUeMac, NrUePhy and NrSpectrumPhy is reached from its device, so setup
+ * is linear in the number of devices, and every callback is bound to the
+ * shard of its node, so tracing does no path or context work.
+ */
+class SlTraceWiring
+{
+  public:
+    /**
+     * \param pscchTx sink of "SlPscchScheduling" (NrUeMac)
+     * \param psschTx sink of "SlPsschScheduling" (NrUeMac)
+     * \param pscchRx sink of "RxPscchTraceUe" (NrSpectrumPhy)
+     * \param psschRx sink of "RxPsschTraceUe" (NrSpectrumPhy)
+     * \param capacity records buffered per node and trace source
+     */
+    SlTraceWiring(SlRecordSink<SlPscchUeMacStatParameters>* pscchTx,
+                  SlRecordSink<SlPsschUeMacStatParameters>* psschTx,
+                  SlRecordSink<SlRxCtrlPacketTraceParams>* pscchRx,
+                  SlRecordSink<SlRxDataPacketTraceParams>* psschRx,
+                  uint32_t capacity);
+
+    /**
+     * Connect the traces of every NrUeNetDevice of \p devices, one shard per
+     * device.
+     * \param devices the UE devices
+     */
+    void Connect(const NetDeviceContainer& devices);
+
+    /// Hand the buffered records to the sinks; call before their EmptyCache.
+    void Flush();
+
+    /// Drop the buffered records, e.g. those of a warm-up.
+    void Discard();
+
+  private:
+    SlTraceShards<SlPscchUeMacStatParameters> m_pscchTx; //!< SlPscchScheduling
+    SlTraceShards<SlPsschUeMacStatParameters> m_psschTx; //!< SlPsschScheduling
+    SlTraceShards<SlRxCtrlPacketTraceParams> m_pscchRx;  //!< RxPscchTraceUe
+    SlTraceShards<SlRxDataPacketTraceParams> m_psschRx;  //!< RxPsschTraceUe
+};
+
+} // namespace ns3
+
+#endif /* SL_TRACE_WIRING_H */
@@ -0,0 +1,475 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-v2x-workload.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/inet-socket-address.h"
+#include "ns3/inet6-socket-address.h"
+#include "ns3/ipv4.h"
+#include "ns3/ipv6.h"
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/packet-sink.h"
+#include "ns3/simulator.h"
+#include "ns3/trace-source-accessor.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <fstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlV2xWorkload");
+
+NS_OBJECT_ENSURE_REGISTERED(SlV2xTrafficApp);
+
+// ETSI EN 302 637-2 CAM generation thresholds
+static const double CAM_HEADING_DEGREES = 4.0;
+static const double CAM_POSITION_METERS = 4.0;
+static const double CAM_SPEED_MPS = 0.5;
+
+/// \return the IP address of an IP, InetSocketAddress or Inet6SocketAddress
+static Address
+HostOf(const Address& address)
+{
+    if (InetSocketAddress::IsMatchingType(address))
+    {
+        return InetSocketAddress::ConvertFrom(address).GetIpv4();
+    }
+    if (Inet6SocketAddress::IsMatchingType(address))
+    {
+        return Inet6SocketAddress::ConvertFrom(address).GetIpv6();
+    }
+    return address;
+}
+
+TypeId
+SlV2xTrafficApp::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlV2xTrafficApp")
+            .SetParent<Application>()
+            .SetGroupName("Applications")
+            .AddConstructor<SlV2xTrafficApp>()
+            .AddAttribute("CamRemote",
+                          "Groupcast address of the CAMs",
+                          AddressValue(),
+                          MakeAddressAccessor(&SlV2xTrafficApp::m_camRemote),
+                          MakeAddressChecker())
+            .AddAttribute("EventRemote",
+                          "Groupcast address of the event messages",
+                          AddressValue(),
+                          MakeAddressAccessor(&SlV2xTrafficApp::m_eventRemote),
+                          MakeAddressChecker())
+            .AddAttribute("CamSize",
+                          "Size of a CAM, SeqTsSizeHeader included",
+                          UintegerValue(190),
+                          MakeUintegerAccessor(&SlV2xTrafficApp::m_camSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("CamPeriod",
+                          "Time between two CAMs; with CamDynamic, between two checks "
+                          "of the generation conditions",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&SlV2xTrafficApp::m_camPeriod),
+                          MakeTimeChecker(MicroSeconds(1)))
+            .AddAttribute("CamJitter",
+                          "Every CAM interval is drawn in CamPeriod +/- CamJitter",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&SlV2xTrafficApp::m_camJitter),
+                          MakeTimeChecker(Seconds(0)))
+            .AddAttribute("CamDynamic",
+                          "Send a CAM only on the ETSI heading, position and speed "
+                          "changes, or after CamMaxInterval",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SlV2xTrafficApp::m_camDynamic),
+                          MakeBooleanChecker())
+            .AddAttribute("CamMaxInterval",
+                          "Longest time between two CAMs with CamDynamic",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&SlV2xTrafficApp::m_camMaxInterval),
+                          MakeTimeChecker())
+            .AddAttribute("EventRate",
+                          "Events per second (Poisson arrivals); 0 disables them",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(&SlV2xTrafficApp::m_eventRate),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute("EventSize",
+                          "Size of an event message, SeqTsSizeHeader included",
+                          UintegerValue(300),
+                          MakeUintegerAccessor(&SlV2xTrafficApp::m_eventSize),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EventRepetitions",
+                          "Messages sent per event",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&SlV2xTrafficApp::m_eventRepetitions),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("EventRepetitionInterval",
+                          "Time between the messages of an event",
+                          TimeValue(MilliSeconds(100)),
+                          MakeTimeAccessor(&SlV2xTrafficApp::m_eventRepetitionInterval),
+                          MakeTimeChecker())
+            .AddTraceSource("TxWithSeqTsSize",
+                            "A message is created, before its SeqTsSizeHeader is added",
+                            MakeTraceSourceAccessor(&SlV2xTrafficApp::m_txTraceWithSeqTsSize),
+                            "ns3::PacketSink::SeqTsSizeCallback");
+    return tid;
+}
+
+SlV2xTrafficApp::SlV2xTrafficApp()
+    : m_uniform(CreateObject<UniformRandomVariable>()),
+      m_interArrival(CreateObject<ExponentialRandomVariable>())
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlV2xTrafficApp::~SlV2xTrafficApp()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+int64_t
+SlV2xTrafficApp::AssignStreams(int64_t stream)
+{
+    m_uniform->SetStream(stream);
+    m_interArrival->SetStream(stream + 1);
+    return 2;
+}
+
+uint64_t
+SlV2xTrafficApp::GetSent(Class cls) const
+{
+    return m_sent[cls];
+}
+
+uint64_t
+SlV2xTrafficApp::GetSentBytes(Class cls) const
+{
+    return m_sentBytes[cls];
+}
+
+void
+SlV2xTrafficApp::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& socket : m_socket)
+    {
+        socket = nullptr;
+    }
+    Application::DoDispose();
+}
+
+void
+SlV2xTrafficApp::StartApplication()
+{
+    NS_LOG_FUNCTION(this);
+    SeqTsSizeHeader header;
+    NS_ABORT_MSG_IF(m_camSize < header.GetSerializedSize() ||
+                        m_eventSize < header.GetSerializedSize(),
+                    "Message smaller than SeqTsSizeHeader");
+    const Address remotes[] = {m_camRemote, m_eventRemote};
+    for (uint32_t cls = 0; cls < CLASSES; ++cls)
+    {
+        if (m_socket[cls])
+        {
+            continue;
+        }
+        m_socket[cls] = Socket::CreateSocket(GetNode(), UdpSocketFactory::GetTypeId());
+        int ret = Inet6SocketAddress::IsMatchingType(remotes[cls]) ? m_socket[cls]->Bind6()
+                                                                    : m_socket[cls]->Bind();
+        NS_ABORT_MSG_IF(ret == -1 || m_socket[cls]->Connect(remotes[cls]) == -1,
+                        "Failed to bind or connect the socket");
+        m_socket[cls]->SetAllowBroadcast(true);
+        m_socket[cls]->ShutdownRecv();
+    }
+
+    Ptr<MobilityModel> mobility = GetNode()->GetObject<MobilityModel>();
+    m_lastPosition = mobility ? mobility->GetPosition() : Vector();
+    m_lastVelocity = mobility ? mobility->GetVelocity() : Vector();
+    m_lastCam = Simulator::Now();
+    Time offset = Seconds(m_uniform->GetValue(0, m_camPeriod.GetSeconds()));
+    m_camEvent = Simulator::Schedule(offset, &SlV2xTrafficApp::CamTick, this);
+    if (m_eventRate > 0)
+    {
+        m_eventEvent = Simulator::Schedule(Seconds(m_interArrival->GetValue(1 / m_eventRate, 0)),
+                                           &SlV2xTrafficApp::EventArrival,
+                                           this);
+    }
+}
+
+void
+SlV2xTrafficApp::StopApplication()
+{
+    NS_LOG_FUNCTION(this);
+    m_camEvent.Cancel();
+    m_eventEvent.Cancel();
+    m_repetitionEvent.Cancel();
+    for (auto& socket : m_socket)
+    {
+        if (socket)
+        {
+            socket->Close();
+        }
+    }
+}
+
+Time
+SlV2xTrafficApp::NextCamInterval()
+{
+    if (m_camJitter.IsZero())
+    {
+        return m_camPeriod;
+    }
+    double jitter = m_camJitter.GetSeconds();
+    return std::max(MicroSeconds(1),
+                    m_camPeriod + Seconds(m_uniform->GetValue(-jitter, jitter)));
+}
+
+void
+SlV2xTrafficApp::CamTick()
+{
+    NS_LOG_FUNCTION(this);
+    bool send = true;
+    Ptr<MobilityModel> mobility = GetNode()->GetObject<MobilityModel>();
+    if (m_camDynamic && mobility)
+    {
+        Vector position = mobility->GetPosition();
+        Vector velocity = mobility->GetVelocity();
+        double speed = std::hypot(velocity.x, velocity.y);
+        double lastSpeed = std::hypot(m_lastVelocity.x, m_lastVelocity.y);
+        double heading = std::atan2(velocity.y, velocity.x) * 180 / M_PI;
+        double lastHeading = std::atan2(m_lastVelocity.y, m_lastVelocity.x) * 180 / M_PI;
+        double turn = std::abs(std::remainder(heading - lastHeading, 360.0));
+        send = Simulator::Now() - m_lastCam >= m_camMaxInterval ||
+               (speed > 0 && lastSpeed > 0 && turn > CAM_HEADING_DEGREES) ||
+               CalculateDistance(position, m_lastPosition) > CAM_POSITION_METERS ||
+               std::abs(speed - lastSpeed) > CAM_SPEED_MPS;
+        if (send)
+        {
+            m_lastPosition = position;
+            m_lastVelocity = velocity;
+        }
+    }
+    if (send)
+    {
+        m_lastCam = Simulator::Now();
+        Send(CAM, m_camSize);
+    }
+    m_camEvent = Simulator::Schedule(NextCamInterval(), &SlV2xTrafficApp::CamTick, this);
+}
+
+void
+SlV2xTrafficApp::EventArrival()
+{
+    NS_LOG_FUNCTION(this);
+    m_repetitionEvent.Cancel();
+    EventRepetition(m_eventRepetitions);
+    m_eventEvent = Simulator::Schedule(Seconds(m_interArrival->GetValue(1 / m_eventRate, 0)),
+                                       &SlV2xTrafficApp::EventArrival,
+                                       this);
+}
+
+void
+SlV2xTrafficApp::EventRepetition(uint32_t left)
+{
+    Send(EVENT, m_eventSize);
+    if (left > 1)
+    {
+        m_repetitionEvent = Simulator::Schedule(m_eventRepetitionInterval,
+                                                &SlV2xTrafficApp::EventRepetition,
+                                                this,
+                                                left - 1);
+    }
+}
+
+void
+SlV2xTrafficApp::Send(Class cls, uint32_t size)
+{
+    Address from;
+    Address to;
+    m_socket[cls]->GetSockName(from);
+    m_socket[cls]->GetPeerName(to);
+    SeqTsSizeHeader header;
+    header.SetSeq(m_seq++);
+    header.SetSize(size);
+    Ptr<Packet> packet = Create<Packet>(size - header.GetSerializedSize());
+    m_txTraceWithSeqTsSize(packet, from, to, header);
+    packet->AddHeader(header);
+    if (m_socket[cls]->Send(packet) == static_cast<int>(size))
+    {
+        ++m_sent[cls];
+        m_sentBytes[cls] += size;
+    }
+}
+
+SlV2xWorkload::SlV2xWorkload()
+{
+    m_factory.SetTypeId(SlV2xTrafficApp::GetTypeId());
+}
+
+void
+SlV2xWorkload::SetAttribute(const std::string& name, const AttributeValue& value)
+{
+    m_factory.Set(name, value);
+}
+
+void
+SlV2xWorkload::SetCamPeriodRange(Time min, Time max)
+{
+    NS_ABORT_MSG_UNLESS(min.IsStrictlyPositive() && max >= min, "Invalid CAM period range");
+    m_camPeriodMin = min;
+    m_camPeriodMax = max;
+}
+
+int64_t
+SlV2xWorkload::Install(NodeContainer ues,
+                       const Address& camGroup,
+                       const Address& eventGroup,
+                       int64_t stream)
+{
+    NS_ABORT_MSG_UNLESS(m_ues.GetN() == 0, "Workload already installed");
+    m_ues = ues;
+    m_flows.assign(ues.GetN() * SlV2xTrafficApp::CLASSES, Flow());
+    Ptr<UniformRandomVariable> periods = CreateObject<UniformRandomVariable>();
+    periods->SetStream(stream);
+    int64_t used = 1;
+
+    bool ipv6 = Inet6SocketAddress::IsMatchingType(camGroup);
+    const Address groups[] = {camGroup, eventGroup};
+    for (uint32_t i = 0; i < ues.GetN(); ++i)
+    {
+        Ptr<Node> node = ues.Get(i);
+        if (ipv6)
+        {
+            m_index[node->GetObject<Ipv6>()->GetAddress(1, 1).GetAddress()] = i;
+        }
+        else
+        {
+            m_index[node->GetObject<Ipv4>()->GetAddress(1, 0).GetLocal()] = i;
+        }
+
+        Ptr<SlV2xTrafficApp> app = m_factory.Create<SlV2xTrafficApp>();
+        app->SetAttribute("CamRemote", AddressValue(camGroup));
+        app->SetAttribute("EventRemote", AddressValue(eventGroup));
+        if (m_camPeriodMax.IsStrictlyPositive())
+        {
+            double period =
+                periods->GetValue(m_camPeriodMin.GetSeconds(), m_camPeriodMax.GetSeconds());
+            app->SetAttribute("CamPeriod", TimeValue(Seconds(period)));
+        }
+        used += app->AssignStreams(stream + used);
+        node->AddApplication(app);
+        m_clients.Add(app);
+
+        for (uint32_t cls = 0; cls < SlV2xTrafficApp::CLASSES; ++cls)
+        {
+            Address local;
+            if (ipv6)
+            {
+                local = Inet6SocketAddress(Ipv6Address::GetAny(),
+                                           Inet6SocketAddress::ConvertFrom(groups[cls]).GetPort());
+            }
+            else
+            {
+                local = InetSocketAddress(Ipv4Address::GetAny(),
+                                          InetSocketAddress::ConvertFrom(groups[cls]).GetPort());
+            }
+            Ptr<PacketSink> sink = CreateObject<PacketSink>();
+            sink->SetAttribute("Protocol", TypeIdValue(UdpSocketFactory::GetTypeId()));
+            sink->SetAttribute("Local", AddressValue(local));
+            sink->SetAttribute("EnableSeqTsSizeHeader", BooleanValue(true));
+            sink->TraceConnectWithoutContext("RxWithSeqTsSize",
+                                             MakeBoundCallback(&SlV2xWorkload::Rx, this, cls));
+            node->AddApplication(sink);
+            m_sinks.Add(sink);
+        }
+    }
+    return used;
+}
+
+ApplicationContainer
+SlV2xWorkload::GetClients() const
+{
+    return m_clients;
+}
+
+ApplicationContainer
+SlV2xWorkload::GetSinks() const
+{
+    return m_sinks;
+}
+
+uint64_t
+SlV2xWorkload::GetTxPackets(SlV2xTrafficApp::Class cls) const
+{
+    uint64_t packets = 0;
+    for (uint32_t i = 0; i < m_clients.GetN(); ++i)
+    {
+        packets += DynamicCast<SlV2xTrafficApp>(m_clients.Get(i))->GetSent(cls);
+    }
+    return packets;
+}
+
+uint64_t
+SlV2xWorkload::GetRxPackets(SlV2xTrafficApp::Class cls) const
+{
+    uint64_t packets = 0;
+    for (uint32_t i = 0; i < m_ues.GetN(); ++i)
+    {
+        packets += m_flows[i * SlV2xTrafficApp::CLASSES + cls].rxPackets;
+    }
+    return packets;
+}
+
+void
+SlV2xWorkload::Rx(SlV2xWorkload* workload,
+                  uint32_t cls,
+                  Ptr<const Packet> packet,
+                  const Address& from,
+                  const Address& to,
+                  const SeqTsSizeHeader& header)
+{
+    auto it = workload->m_index.find(HostOf(from));
+    if (it == workload->m_index.end())
+    {
+        NS_LOG_WARN("Reception from unknown source " << from);
+        ++workload->m_unknown;
+        return;
+    }
+    Flow& flow = workload->m_flows[it->second * SlV2xTrafficApp::CLASSES + cls];
+    ++flow.rxPackets;
+    flow.rxBytes += packet->GetSize() + header.GetSerializedSize();
+    flow.latency += (Simulator::Now() - header.GetTs()).GetSeconds();
+}
+
+void
+SlV2xWorkload::Write(const std::string& prefix) const
+{
+    const char* names[] = {"cam", "event"};
+    std::ofstream out(prefix + "-v2x-flows.csv");
+    out << "node,class,txPackets,txBytes,rxPackets,rxBytes,receiversPerPacket,latencyMean\n";
+    for (uint32_t i = 0; i < m_ues.GetN(); ++i)
+    {
+        auto app = DynamicCast<SlV2xTrafficApp>(m_clients.Get(i));
+        for (uint32_t cls = 0; cls < SlV2xTrafficApp::CLASSES; ++cls)
+        {
+            auto c = static_cast<SlV2xTrafficApp::Class>(cls);
+            const Flow& flow = m_flows[i * SlV2xTrafficApp::CLASSES + cls];
+            uint64_t sent = app->GetSent(c);
+            out << m_ues.Get(i)->GetId() << "," << names[cls] << "," << sent << ","
+                << app->GetSentBytes(c) << "," << flow.rxPackets << "," << flow.rxBytes << ","
+                << (sent ? static_cast<double>(flow.rxPackets) / sent : 0.0) << ","
+                << (flow.rxPackets ? flow.latency / flow.rxPackets : 0.0) << "\n";
+        }
+    }
+    if (m_unknown > 0)
+    {
+        NS_LOG_WARN(m_unknown << " receptions from unknown sources");
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,244 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_V2X_WORKLOAD_H
+#define SL_V2X_WORKLOAD_H
+
+#include "ns3/address.h"
+#include "ns3/application-container.h"
+#include "ns3/application.h"
+#include "ns3/event-id.h"
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/seq-ts-size-header.h"
+#include "ns3/socket.h"
+#include "ns3/traced-callback.h"
+#include "ns3/vector.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief V2X traffic of one UE: periodic CAM-like and event-triggered
+ * DENM-like messages, sent to two groupcast addresses.
+ *
+ * CAMs of CamSize bytes are sent every CamPeriod, each interval drawn in
+ * CamPeriod +/- CamJitter. With CamDynamic, the period is instead the
+ * T_CheckCamGen of ETSI EN 302 637-2: a CAM is sent when the heading
+ * changed by more than 4 degrees, the position by more than 4 m or the
+ * speed by more than 0.5 m/s since the last CAM, and at least every
+ * CamMaxInterval. Events arrive as a Poisson process of EventRate per
+ * second; each sends EventRepetitions messages of EventSize bytes,
+ * EventRepetitionInterval apart. The first CAM is sent at a random offset
+ * within a period of the start, so the UEs are not synchronized.
+ *
+ * Every packet carries a SeqTsSizeHeader; TxWithSeqTsSize has the
+ * signature of the OnOffApplication trace.
+ */
+class SlV2xTrafficApp : public Application
+{
+  public:
+    /// Message classes.
+    enum Class : uint32_t
+    {
+        CAM = 0,   //!< periodic awareness messages
+        EVENT = 1, //!< event-triggered messages
+        CLASSES = 2
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlV2xTrafficApp();
+    ~SlV2xTrafficApp() override;
+
+    /**
+     * \param stream first stream index to use
+     * \return number of stream indices used
+     */
+    int64_t AssignStreams(int64_t stream);
+
+    /**
+     * \param cls message class
+     * \return messages of the class sent
+     */
+    uint64_t GetSent(Class cls) const;
+
+    /**
+     * \param cls message class
+     * \return bytes of the class sent
+     */
+    uint64_t GetSentBytes(Class cls) const;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    void StartApplication() override;
+    void StopApplication() override;
+
+    /// Send a CAM, or check the CAM triggering conditions, and reschedule.
+    void CamTick();
+
+    /// Send the messages of a new event and schedule the next event.
+    void EventArrival();
+
+    /// \param left repetitions of the current event still to send
+    void EventRepetition(uint32_t left);
+
+    /**
+     * \param cls message class
+     * \param size message size, SeqTsSizeHeader included
+     */
+    void Send(Class cls, uint32_t size);
+
+    /// \return the next CAM interval, with jitter
+    Time NextCamInterval();
+
+    Address m_camRemote;            //!< groupcast destination of the CAMs
+    Address m_eventRemote;          //!< groupcast destination of the events
+    Ptr<Socket> m_socket[CLASSES];  //!< socket per class
+    uint32_t m_camSize;             //!< CAM size
+    Time m_camPeriod;               //!< CAM period, or T_CheckCamGen
+    Time m_camJitter;               //!< CAM interval jitter
+    bool m_camDynamic;              //!< ETSI triggering conditions
+    Time m_camMaxInterval;          //!< longest time between two CAMs
+    double m_eventRate;             //!< events per second
+    uint32_t m_eventSize;           //!< event message size
+    uint32_t m_eventRepetitions;    //!< messages per event
+    Time m_eventRepetitionInterval; //!< time between the messages of an event
+
+    Ptr<UniformRandomVariable> m_uniform;          //!< start offset and jitter
+    Ptr<ExponentialRandomVariable> m_interArrival; //!< time between events
+    EventId m_camEvent;                            //!< next CamTick()
+    EventId m_eventEvent;                          //!< next EventArrival()
+    EventId m_repetitionEvent;                     //!< next EventRepetition()
+    Time m_lastCam;                                //!< time of the last CAM
+    Vector m_lastPosition;                         //!< position at the last CAM
+    Vector m_lastVelocity;                         //!< velocity at the last CAM
+    uint32_t m_seq{0};                             //!< next sequence number
+    uint64_t m_sent[CLASSES]{};                    //!< messages sent per class
+    uint64_t m_sentBytes[CLASSES]{};               //!< bytes sent per class
+
+    TracedCallback<Ptr<const Packet>, const Address&, const Address&, const SeqTsSizeHeader&>
+        m_txTraceWithSeqTsSize; //!< messages sent, before the header is added
+};
+
+/**
+ * \brief All-to-all V2X workload: an SlV2xTrafficApp and one PacketSink per
+ * message class on every UE, with per-flow accounting.
+ *
+ * A flow is a (source UE, message class) pair. Its transmissions are read
+ * from the application and its receptions are counted by the sinks of all
+ * the other UEs, in a flat array indexed by UE and class; the source UE of
+ * a reception is found from its address.
+ */
+class SlV2xWorkload
+{
+  public:
+    SlV2xWorkload();
+
+    SlV2xWorkload(const SlV2xWorkload&) = delete;
+    SlV2xWorkload& operator=(const SlV2xWorkload&) = delete;
+
+    /**
+     * Set an attribute of every SlV2xTrafficApp installed afterwards.
+     * \param name attribute name
+     * \param value attribute value
+     */
+    void SetAttribute(const std::string& name, const AttributeValue& value);
+
+    /**
+     * Draw the CamPeriod of every UE uniformly in [min, max].
+     * \param min shortest period
+     * \param max longest period
+     */
+    void SetCamPeriodRange(Time min, Time max);
+
+    /**
+     * Install the workload; the UEs must have their IP addresses.
+     * \param ues the UEs
+     * \param camGroup groupcast socket address of the CAMs
+     * \param eventGroup groupcast socket address of the event messages
+     * \param stream first random stream index to use
+     * \return number of stream indices used
+     */
+    int64_t Install(NodeContainer ues,
+                    const Address& camGroup,
+                    const Address& eventGroup,
+                    int64_t stream);
+
+    /// \return the traffic applications, one per UE
+    ApplicationContainer GetClients() const;
+
+    /// \return the sinks, one per UE and message class
+    ApplicationContainer GetSinks() const;
+
+    /**
+     * \param cls message class
+     * \return messages of the class sent by all the UEs
+     */
+    uint64_t GetTxPackets(SlV2xTrafficApp::Class cls) const;
+
+    /**
+     * \param cls message class
+     * \return receptions of messages of the class by all the UEs
+     */
+    uint64_t GetRxPackets(SlV2xTrafficApp::Class cls) const;
+
+    /**
+     * Write <prefix>-v2x-flows.csv: per flow, the messages and bytes sent,
+     * the receptions, and their mean latency.
+     * \param prefix output path without suffix
+     */
+    void Write(const std::string& prefix) const;
+
+  private:
+    /// Receptions of one flow.
+    struct Flow
+    {
+        uint64_t rxPackets{0}; //!< receptions by the other UEs
+        uint64_t rxBytes{0};   //!< bytes received
+        double latency{0};     //!< sum of the latencies, in seconds
+    };
+
+    /**
+     * RxWithSeqTsSize sink of the PacketSinks.
+     * \param workload the workload
+     * \param cls class of the messages of the sink
+     * \param packet the packet, without the header
+     * \param from source address
+     * \param to local address
+     * \param header the header of the packet
+     */
+    static void Rx(SlV2xWorkload* workload,
+                   uint32_t cls,
+                   Ptr<const Packet> packet,
+                   const Address& from,
+                   const Address& to,
+                   const SeqTsSizeHeader& header);
+
+    ObjectFactory m_factory;             //!< factory of the applications
+    Time m_camPeriodMin;                 //!< shortest CAM period
+    Time m_camPeriodMax;                 //!< longest CAM period
+    NodeContainer m_ues;                 //!< the UEs, by index
+    ApplicationContainer m_clients;      //!< applications, by UE index
+    ApplicationContainer m_sinks;        //!< sinks
+    std::map<Address, uint32_t> m_index; //!< UE index of every IP address
+    std::vector<Flow> m_flows;           //!< index: UE index * CLASSES + class
+    uint64_t m_unknown{0};               //!< receptions from unknown sources
+};
+
+} // namespace ns3
+
+#endif /* SL_V2X_WORKLOAD_H */
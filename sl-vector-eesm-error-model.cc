@@ -0,0 +1,130 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sl-vector-eesm-error-model.h"
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlVectorEesmIrT1");
+
+NS_OBJECT_ENSURE_REGISTERED(SlVectorEesmIrT1);
+
+uint64_t SlVectorEesmIrT1::s_kernelCalls = 0;
+uint64_t SlVectorEesmIrT1::s_verified = 0;
+uint64_t SlVectorEesmIrT1::s_mismatches = 0;
+double SlVectorEesmIrT1::s_maxRelativeError = 0;
+
+TypeId
+SlVectorEesmIrT1::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlVectorEesmIrT1")
+            .SetParent<NrEesmIrT1>()
+            .SetGroupName("Nr")
+            .AddConstructor<SlVectorEesmIrT1>()
+            .AddAttribute("Kernel",
+                          "Implementation of the effective SINR: auto, scalar, avx2 or avx512",
+                          StringValue("auto"),
+                          MakeStringAccessor(&SlVectorEesmIrT1::SetKernel),
+                          MakeStringChecker())
+            .AddAttribute("Verify",
+                          "Also compute every effective SINR with NrEesmIr and compare",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&SlVectorEesmIrT1::m_verify),
+                          MakeBooleanChecker())
+            .AddAttribute("VerifyTolerance",
+                          "Largest relative difference with NrEesmIr counted as a match",
+                          DoubleValue(1e-9),
+                          MakeDoubleAccessor(&SlVectorEesmIrT1::m_tolerance),
+                          MakeDoubleChecker<double>(0.0));
+    return tid;
+}
+
+SlVectorEesmIrT1::SlVectorEesmIrT1()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlVectorEesmIrT1::~SlVectorEesmIrT1()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SlVectorEesmIrT1::SetKernel(std::string name)
+{
+    m_isa = SlEesmKernel::Parse(name);
+    NS_LOG_INFO("EESM kernel " << SlEesmKernel::GetName(m_isa));
+}
+
+double
+SlVectorEesmIrT1::ComputeSINR(const SpectrumValue& sinr,
+                              const std::vector<int>& map,
+                              uint8_t mcs,
+                              uint32_t sizeBit,
+                              const NrErrorModel::NrErrorModelHistory& sinrHistory) const
+{
+    if (!sinrHistory.empty())
+    {
+        return NrEesmIrT1::ComputeSINR(sinr, map, mcs, sizeBit, sinrHistory);
+    }
+
+    ++s_kernelCalls;
+    double effective = SlEesmKernel::EffectiveSinr(m_isa,
+                                                   &(*sinr.ConstValuesBegin()),
+                                                   map.data(),
+                                                   map.size(),
+                                                   GetBetaTable()->at(mcs));
+    if (m_verify)
+    {
+        double stock = NrEesmIrT1::ComputeSINR(sinr, map, mcs, sizeBit, sinrHistory);
+        if (std::isfinite(stock))
+        {
+            ++s_verified;
+            double error = std::fabs(effective - stock) / std::max(std::fabs(stock), 1e-300);
+            s_maxRelativeError = std::max(s_maxRelativeError, error);
+            if (error > m_tolerance)
+            {
+                ++s_mismatches;
+                NS_LOG_WARN("EESM mismatch: kernel " << effective << ", NrEesmIr " << stock
+                                                     << ", MCS " << +mcs);
+            }
+        }
+    }
+    return effective;
+}
+
+uint64_t
+SlVectorEesmIrT1::GetKernelCalls()
+{
+    return s_kernelCalls;
+}
+
+uint64_t
+SlVectorEesmIrT1::GetVerified()
+{
+    return s_verified;
+}
+
+uint64_t
+SlVectorEesmIrT1::GetMismatches()
+{
+    return s_mismatches;
+}
+
+double
+SlVectorEesmIrT1::GetMaxRelativeError()
+{
+    return s_maxRelativeError;
+}
+
+} // namespace ns3
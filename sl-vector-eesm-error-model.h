@@ -0,0 +1,75 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SL_VECTOR_EESM_ERROR_MODEL_H
+#define SL_VECTOR_EESM_ERROR_MODEL_H
+
+#include "sl-eesm-kernel.h"
+
+#include "ns3/nr-eesm-ir-t1.h"
+
+#include <cstdint>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \brief NrEesmIrT1 computing the effective SINR with SlEesmKernel.
+ *
+ * First transmissions, the bulk of the sidelink receptions, are mapped by
+ * the vectorized kernel; retransmissions, whose incremental redundancy
+ * combining depends on the history of the HARQ process, keep the path of
+ * NrEesmIr. With Verify, every mapping is also computed by NrEesmIr and the
+ * relative difference is checked against VerifyTolerance.
+ *
+ * The counters are shared by all the instances (one per PHY and per AMC).
+ */
+class SlVectorEesmIrT1 : public NrEesmIrT1
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlVectorEesmIrT1();
+    ~SlVectorEesmIrT1() override;
+
+    /// \return effective SINR mappings done by the kernel
+    static uint64_t GetKernelCalls();
+
+    /// \return mappings compared with NrEesmIr
+    static uint64_t GetVerified();
+
+    /// \return compared mappings beyond VerifyTolerance
+    static uint64_t GetMismatches();
+
+    /// \return largest relative difference with NrEesmIr
+    static double GetMaxRelativeError();
+
+  protected:
+    double ComputeSINR(const SpectrumValue& sinr,
+                       const std::vector<int>& map,
+                       uint8_t mcs,
+                       uint32_t sizeBit,
+                       const NrErrorModel::NrErrorModelHistory& sinrHistory) const override;
+
+  private:
+    /// \param name name of the kernel, see SlEesmKernel::Parse
+    void SetKernel(std::string name);
+
+    SlEesmKernel::Isa m_isa{SlEesmKernel::SCALAR}; //!< kernel in use
+    bool m_verify;                                 //!< compare with NrEesmIr
+    double m_tolerance;                            //!< largest relative difference
+
+    static uint64_t s_kernelCalls;    //!< mappings done by the kernel
+    static uint64_t s_verified;       //!< mappings compared
+    static uint64_t s_mismatches;     //!< mappings beyond the tolerance
+    static double s_maxRelativeError; //!< largest relative difference
+};
+
+} // namespace ns3
+
+#endif /* SL_VECTOR_EESM_ERROR_MODEL_H */
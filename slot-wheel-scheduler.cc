@@ -0,0 +1,267 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "slot-wheel-scheduler.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SlotWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(SlotWheelScheduler);
+
+/// Order of a sorted bucket: the next event last.
+static bool
+Later(const Scheduler::Event& a, const Scheduler::Event& b)
+{
+    return b.key < a.key;
+}
+
+TypeId
+SlotWheelScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::SlotWheelScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<SlotWheelScheduler>()
+            .AddAttribute("SlotDuration",
+                          "Duration of a bucket; the slot of the numerology of the PHYs",
+                          TimeValue(NanoSeconds(62500)),
+                          MakeTimeAccessor(&SlotWheelScheduler::SetSlotDuration),
+                          MakeTimeChecker(TimeStep(1)));
+    return tid;
+}
+
+SlotWheelScheduler::SlotWheelScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+SlotWheelScheduler::~SlotWheelScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+SlotWheelScheduler::SetSlotDuration(Time duration)
+{
+    NS_ABORT_MSG_IF(m_count > 0, "Slot duration set with queued events");
+    m_slotTicks = duration.GetTimeStep();
+}
+
+uint32_t
+SlotWheelScheduler::FindFirst(const Bitmap& bitmap, uint32_t from)
+{
+    for (uint32_t word = from / 64; word < WORDS; ++word)
+    {
+        uint64_t bits = bitmap[word];
+        if (word == from / 64)
+        {
+            bits &= ~uint64_t(0) << (from % 64);
+        }
+        if (bits != 0)
+        {
+            return word * 64 + __builtin_ctzll(bits);
+        }
+    }
+    return SIZE;
+}
+
+void
+SlotWheelScheduler::Insert(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t slot = ev.key.m_ts / m_slotTicks;
+    if (m_count++ == 0)
+    {
+        // Empty: the wheels can start anywhere
+        m_current = slot;
+    }
+    if (slot <= m_current)
+    {
+        InsertCurrent(ev);
+    }
+    else
+    {
+        File(ev);
+    }
+}
+
+void
+SlotWheelScheduler::File(const Scheduler::Event& ev)
+{
+    uint64_t slot = ev.key.m_ts / m_slotTicks;
+    uint64_t block = slot >> BITS;
+    uint64_t current = m_current >> BITS;
+    if (block == current)
+    {
+        m_slots[slot & MASK].push_back(ev);
+        m_slotBits[(slot & MASK) / 64] |= uint64_t(1) << (slot % 64);
+    }
+    else if (block - current < SIZE)
+    {
+        m_blocks[block & MASK].push_back(ev);
+        m_blockBits[(block & MASK) / 64] |= uint64_t(1) << (block % 64);
+    }
+    else
+    {
+        m_overflow.emplace(ev.key, ev.impl);
+    }
+}
+
+void
+SlotWheelScheduler::InsertCurrent(const Scheduler::Event& ev)
+{
+    uint32_t i = m_current & MASK;
+    Bucket& bucket = m_slots[i];
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), ev, &Later), ev);
+    m_slotBits[i / 64] |= uint64_t(1) << (i % 64);
+}
+
+bool
+SlotWheelScheduler::IsEmpty() const
+{
+    return m_count == 0;
+}
+
+Scheduler::Event
+SlotWheelScheduler::PeekNext() const
+{
+    NS_ASSERT(m_count > 0);
+    return m_slots[m_current & MASK].back();
+}
+
+Scheduler::Event
+SlotWheelScheduler::RemoveNext()
+{
+    NS_ASSERT(m_count > 0);
+    uint32_t i = m_current & MASK;
+    Bucket& bucket = m_slots[i];
+    Scheduler::Event ev = bucket.back();
+    bucket.pop_back();
+    --m_count;
+    if (bucket.empty())
+    {
+        m_slotBits[i / 64] &= ~(uint64_t(1) << (i % 64));
+        if (m_count > 0)
+        {
+            Advance();
+        }
+    }
+    return ev;
+}
+
+void
+SlotWheelScheduler::Remove(const Scheduler::Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    uint64_t slot = ev.key.m_ts / m_slotTicks;
+    uint64_t block = slot >> BITS;
+    uint64_t current = m_current >> BITS;
+    auto sameUid = [&ev](const Scheduler::Event& other) {
+        return other.key.m_uid == ev.key.m_uid;
+    };
+    --m_count;
+    if (slot <= m_current)
+    {
+        // Keep the current bucket sorted
+        uint32_t i = m_current & MASK;
+        Bucket& bucket = m_slots[i];
+        auto it = std::find_if(bucket.begin(), bucket.end(), sameUid);
+        NS_ASSERT(it != bucket.end());
+        bucket.erase(it);
+        if (bucket.empty())
+        {
+            m_slotBits[i / 64] &= ~(uint64_t(1) << (i % 64));
+            if (m_count > 0)
+            {
+                Advance();
+            }
+        }
+        return;
+    }
+    if (block - current >= SIZE)
+    {
+        m_overflow.erase(ev.key);
+        return;
+    }
+    bool inSlots = block == current;
+    uint32_t i = (inSlots ? slot : block) & MASK;
+    Bucket& bucket = inSlots ? m_slots[i] : m_blocks[i];
+    Bitmap& bits = inSlots ? m_slotBits : m_blockBits;
+    auto it = std::find_if(bucket.begin(), bucket.end(), sameUid);
+    NS_ASSERT(it != bucket.end());
+    *it = bucket.back();
+    bucket.pop_back();
+    if (bucket.empty())
+    {
+        bits[i / 64] &= ~(uint64_t(1) << (i % 64));
+    }
+}
+
+void
+SlotWheelScheduler::Advance()
+{
+    while (true)
+    {
+        uint32_t i = FindFirst(m_slotBits, (m_current & MASK) + 1);
+        if (i < SIZE)
+        {
+            m_current = (m_current & ~MASK) | i;
+            std::sort(m_slots[i].begin(), m_slots[i].end(), &Later);
+            return;
+        }
+        uint64_t current = m_current >> BITS;
+        uint32_t from = (current + 1) & MASK;
+        uint32_t j = FindFirst(m_blockBits, from);
+        if (j == SIZE)
+        {
+            j = FindFirst(m_blockBits, 0);
+        }
+        uint64_t next;
+        if (j < SIZE)
+        {
+            next = current + 1 + ((j - from) & MASK);
+        }
+        else
+        {
+            NS_ASSERT(!m_overflow.empty());
+            next = (m_overflow.begin()->first.m_ts / m_slotTicks) >> BITS;
+        }
+        Cascade(next);
+        if (!m_slots[0].empty())
+        {
+            std::sort(m_slots[0].begin(), m_slots[0].end(), &Later);
+            return;
+        }
+    }
+}
+
+void
+SlotWheelScheduler::Cascade(uint64_t block)
+{
+    m_current = block << BITS;
+    uint32_t j = block & MASK;
+    for (const auto& ev : m_blocks[j])
+    {
+        File(ev);
+    }
+    m_blocks[j].clear();
+    m_blockBits[j / 64] &= ~(uint64_t(1) << (j % 64));
+    while (!m_overflow.empty() &&
+           ((m_overflow.begin()->first.m_ts / m_slotTicks) >> BITS) - block < SIZE)
+    {
+        auto first = m_overflow.begin();
+        File(Scheduler::Event{first->second, first->first});
+        m_overflow.erase(first);
+    }
+}
+
+} // namespace ns3
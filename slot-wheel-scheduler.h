@@ -0,0 +1,107 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SLOT_WHEEL_SCHEDULER_H
+#define SLOT_WHEEL_SCHEDULER_H
+
+#include "ns3/nstime.h"
+#include "ns3/scheduler.h"
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Hierarchical timing wheel whose buckets are NR slots.
+ *
+ * The PHYs and MACs of a numerology schedule most of their events on the
+ * slot grid, so an event is filed by its slot, ts / SlotDuration, instead
+ * of being inserted in a tree. The first wheel has a bucket per slot of
+ * the current block of 256 slots; the second a bucket per block of the
+ * next 255 blocks; later events wait in a map and move to the wheels as
+ * their block comes near. Inserting is O(1) outside the current slot. A
+ * bucket is sorted once, when it becomes the current slot, and events
+ * added to the current slot are inserted in place, so the events run in
+ * the (timestamp, uid) order of the other schedulers and the simulation is
+ * unchanged. The next non-empty bucket is found in a bitmap of each wheel.
+ */
+class SlotWheelScheduler : public Scheduler
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    SlotWheelScheduler();
+    ~SlotWheelScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+
+  private:
+    static constexpr uint32_t BITS = 8;          //!< log2 of the buckets of a wheel
+    static constexpr uint32_t SIZE = 1 << BITS;  //!< buckets of a wheel
+    static constexpr uint64_t MASK = SIZE - 1;   //!< bucket of a slot or block
+    static constexpr uint32_t WORDS = SIZE / 64; //!< words of the bitmaps
+
+    /// Events of a slot, or of a block of slots.
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /// Bitmap of the non-empty buckets of a wheel.
+    typedef std::array<uint64_t, WORDS> Bitmap;
+
+    /// \param duration slot duration
+    void SetSlotDuration(Time duration);
+
+    /**
+     * File \p ev in the wheels or in the map, after the current slot.
+     * \param ev the event
+     */
+    void File(const Scheduler::Event& ev);
+
+    /**
+     * Insert \p ev in the sorted bucket of the current slot.
+     * \param ev the event
+     */
+    void InsertCurrent(const Scheduler::Event& ev);
+
+    /// Make the bucket of the first event the current slot.
+    void Advance();
+
+    /**
+     * Start the block \p block: move its bucket of the second wheel to the
+     * first, and the map events of the next blocks to the second wheel.
+     * \param block the new current block
+     */
+    void Cascade(uint64_t block);
+
+    /**
+     * \param bitmap bitmap of a wheel
+     * \param from first bucket to look at
+     * \return first non-empty bucket from \p from, or SIZE
+     */
+    static uint32_t FindFirst(const Bitmap& bitmap, uint32_t from);
+
+    int64_t m_slotTicks{62500};                           //!< slot duration, in time steps
+    uint64_t m_current{0};                                //!< slot of the current bucket
+    uint64_t m_count{0};                                  //!< queued events
+    std::array<Bucket, SIZE> m_slots;                     //!< first wheel, a bucket per slot
+    std::array<Bucket, SIZE> m_blocks;                    //!< second wheel, per block
+    Bitmap m_slotBits{};                                  //!< non-empty m_slots
+    Bitmap m_blockBits{};                                 //!< non-empty m_blocks
+    std::map<Scheduler::EventKey, EventImpl*> m_overflow; //!< events of later blocks
+};
+
+} // namespace ns3
+
+#endif /* SLOT_WHEEL_SCHEDULER_H */
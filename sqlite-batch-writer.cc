@@ -0,0 +1,116 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#include "sqlite-batch-writer.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SqliteBatchWriter");
+
+SqliteBatchWriter::SqliteBatchWriter(SQLiteOutput* db, bool background, uint32_t maxPendingBatches)
+    : m_db(db),
+      m_background(background),
+      m_maxPending(std::max<uint32_t>(maxPendingBatches, 1))
+{
+    if (m_background)
+    {
+        m_thread = std::thread(&SqliteBatchWriter::Run, this);
+    }
+}
+
+SqliteBatchWriter::~SqliteBatchWriter()
+{
+    if (m_background)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+    for (auto stmt : m_statements)
+    {
+        SQLiteOutput::SpinFinalize(stmt);
+    }
+}
+
+SQLiteOutput*
+SqliteBatchWriter::GetDb() const
+{
+    return m_db;
+}
+
+sqlite3_stmt*
+SqliteBatchWriter::Prepare(const std::string& sql)
+{
+    Drain();
+    sqlite3_stmt* stmt = nullptr;
+    bool ret = m_db->SpinPrepare(&stmt, sql);
+    NS_ABORT_MSG_UNLESS(ret, "Could not prepare " << sql);
+    m_statements.push_back(stmt);
+    return stmt;
+}
+
+void
+SqliteBatchWriter::Submit(std::function<void()> batch)
+{
+    if (!m_background)
+    {
+        Write(batch);
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_queue.size() < m_maxPending; });
+    m_queue.emplace_back(std::move(batch));
+    m_cv.notify_all();
+}
+
+void
+SqliteBatchWriter::Drain()
+{
+    if (!m_background)
+    {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this]() { return m_queue.empty() && !m_busy; });
+}
+
+void
+SqliteBatchWriter::Run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_cv.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            return;
+        }
+        std::function<void()> batch = std::move(m_queue.front());
+        m_queue.pop_front();
+        m_busy = true;
+        m_cv.notify_all();
+        lock.unlock();
+        Write(batch);
+        lock.lock();
+        m_busy = false;
+        m_cv.notify_all();
+    }
+}
+
+void
+SqliteBatchWriter::Write(const std::function<void()>& batch)
+{
+    bool ret = m_db->SpinExec("BEGIN TRANSACTION;");
+    NS_ABORT_MSG_UNLESS(ret, "Could not begin a transaction");
+    batch();
+    ret = m_db->SpinExec("END TRANSACTION;");
+    NS_ABORT_MSG_UNLESS(ret, "Could not commit a transaction");
+}
+
+} // namespace ns3
@@ -0,0 +1,171 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+#ifndef SQLITE_BATCH_WRITER_H
+#define SQLITE_BATCH_WRITER_H
+
+#include "ns3/abort.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/sqlite-output.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <sqlite3.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \brief Serialized, batched writes into one SQLite database.
+ *
+ * Every batch runs inside a single transaction. With a background thread,
+ * batches are written while the simulation continues; the number of batches
+ * waiting to be written is bounded, and Submit() blocks when the bound is
+ * reached, so memory never grows past (pending + 1) batches per table.
+ *
+ * All the tables of a database share one writer: a SQLite connection can
+ * only have one open transaction.
+ */
+class SqliteBatchWriter : public SimpleRefCount<SqliteBatchWriter>
+{
+  public:
+    /**
+     * \param db the database, must outlive the writer
+     * \param background write batches from a dedicated thread
+     * \param maxPendingBatches batches that may wait for the writer thread
+     */
+    SqliteBatchWriter(SQLiteOutput* db, bool background, uint32_t maxPendingBatches = 4);
+    ~SqliteBatchWriter();
+
+    SqliteBatchWriter(const SqliteBatchWriter&) = delete;
+    SqliteBatchWriter& operator=(const SqliteBatchWriter&) = delete;
+
+    /// \return the database
+    SQLiteOutput* GetDb() const;
+
+    /**
+     * Prepare a statement that stays valid until the writer is destroyed.
+     * Must be called from the simulation thread, before the statement is
+     * used in a batch.
+     * \param sql the statement
+     * \return the prepared statement
+     */
+    sqlite3_stmt* Prepare(const std::string& sql);
+
+    /**
+     * Queue \p batch, which is run between BEGIN and COMMIT.
+     * \param batch the writes
+     */
+    void Submit(std::function<void()> batch);
+
+    /// Block until every submitted batch is in the database.
+    void Drain();
+
+  private:
+    /// Body of the writer thread.
+    void Run();
+    /// Run \p batch inside a transaction.
+    void Write(const std::function<void()>& batch);
+
+    SQLiteOutput* m_db;                        //!< the database
+    bool m_background;                         //!< true if m_thread is used
+    uint32_t m_maxPending;                     //!< bound of m_queue
+    std::vector<sqlite3_stmt*> m_statements;   //!< finalized on destruction
+    std::deque<std::function<void()>> m_queue; //!< batches not written yet
+    bool m_busy{false};                        //!< the thread is writing a batch
+    bool m_stop{false};                        //!< ask the thread to exit
+    std::mutex m_mutex;                        //!< protects the queue
+    std::condition_variable m_cv;              //!< queue changes
+    std::thread m_thread;                      //!< background writer
+};
+
+/**
+ * \brief Rows of one table, written by a SqliteBatchWriter in batches.
+ *
+ * Rows are kept in a vector and handed to the writer once \p batchSize
+ * rows are collected; the whole batch is inserted with a single prepared
+ * statement which is bound, stepped and reset for every row.
+ */
+template <typename Row>
+class SqliteBatchTable
+{
+  public:
+    /// Bind the columns of a row to the INSERT statement.
+    using Binder = void (*)(sqlite3_stmt*, const Row&);
+
+    /**
+     * \param writer the database writer
+     * \param insertSql "INSERT INTO table VALUES (?,...)"
+     * \param binder binds one row
+     * \param batchSize rows per batch
+     */
+    void Open(Ptr<SqliteBatchWriter> writer,
+              const std::string& insertSql,
+              Binder binder,
+              uint32_t batchSize)
+    {
+        m_writer = writer;
+        m_statement = writer->Prepare(insertSql);
+        m_binder = binder;
+        m_batchSize = std::max<uint32_t>(batchSize, 1);
+        m_rows.reserve(m_batchSize);
+    }
+
+    /// \param row appended to the current batch
+    void Add(Row row)
+    {
+        m_rows.emplace_back(std::move(row));
+        if (m_rows.size() >= m_batchSize)
+        {
+            Flush();
+        }
+    }
+
+    /// Hand the current batch to the writer.
+    void Flush()
+    {
+        if (m_rows.empty())
+        {
+            return;
+        }
+        auto rows = std::make_shared<std::vector<Row>>(std::move(m_rows));
+        m_rows = std::vector<Row>();
+        m_rows.reserve(m_batchSize);
+        sqlite3_stmt* stmt = m_statement;
+        Binder binder = m_binder;
+        m_writer->Submit([stmt, binder, rows]() {
+            for (const auto& row : *rows)
+            {
+                binder(stmt, row);
+                int rc = SQLiteOutput::SpinStep(stmt);
+                NS_ABORT_MSG_UNLESS(rc == SQLITE_DONE, "INSERT failed: " << sqlite3_errstr(rc));
+                SQLiteOutput::SpinReset(stmt);
+            }
+        });
+    }
+
+    /// Flush and wait until every row is in the database.
+    void EmptyCache()
+    {
+        Flush();
+        m_writer->Drain();
+    }
+
+  private:
+    Ptr<SqliteBatchWriter> m_writer;    //!< database writer
+    sqlite3_stmt* m_statement{nullptr}; //!< INSERT statement
+    Binder m_binder{nullptr};           //!< binds one row
+    uint32_t m_batchSize{1};            //!< rows per batch
+    std::vector<Row> m_rows;            //!< current batch
+};
+
+} // namespace ns3
+
+#endif /* SQLITE_BATCH_WRITER_H */
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+"""
+Events per second of exp01_5glena_mobility in the ns-3 build profiles.
+
+The debug profile keeps the diagnostics of the experiment (packet metadata
+printing/checking, LOG_LEVEL_ALL of the EPC and BWP helpers); release and
+optimized compile them out (EXP01_DIAGNOSTICS in exp01_5glena_mobility.cc).
+For every profile the script reconfigures and rebuilds ns-3, keeps a copy of
+the executable, runs it --repeats times on the same trace and reports the
+median of the "Events per second" line. Run from the ns-3 root:
+
+  ./scratch/one_v2x/sweep/exp01_profile_bench.py --profiles debug,optimized \\
+      --configure-args="--enable-sqlite" -- --mobilityTrace=mob01.tcl
+
+The last configured profile stays active; reconfigure afterwards if needed.
+"""
+
+import argparse
+import json
+import os
+import re
+import shlex
+import shutil
+import statistics
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from exp01_sweep import find_program  # noqa: E402
+
+METRICS = {
+    "diagnostics": re.compile(r"^Diagnostics = (\d+)", re.M),
+    "events": re.compile(r"^Executed events = (\d+)", re.M),
+    "wall": re.compile(r"^Run wall clock = ([0-9.eE+-]+) sec", re.M),
+    "eventsPerSecond": re.compile(r"^Events per second = ([0-9.eE+-]+)", re.M),
+}
+
+
+def build(ns3_dir, profile, configure_args, out):
+    ns3 = os.path.join(ns3_dir, "ns3")
+    subprocess.run([ns3, "configure", "--build-profile=%s" % profile] + configure_args,
+                   cwd=ns3_dir, check=True)
+    subprocess.run([ns3, "build"], cwd=ns3_dir, check=True)
+    program = os.path.join(out, "exp01-%s" % profile)
+    shutil.copy2(find_program(ns3_dir), program)
+    return program
+
+
+def run(ns3_dir, program, profile, repeat, out, extra):
+    tag = "bench-%s-%d" % (profile, repeat)
+    command = [program, "--simTag=%s" % tag, "--outputDir=%s/" % out] + extra
+    result = subprocess.run(command, cwd=ns3_dir, capture_output=True, text=True)
+    with open(os.path.join(out, tag + ".log"), "w") as log:
+        log.write(result.stdout)
+        log.write(result.stderr)
+    if result.returncode != 0:
+        sys.exit("%s failed, see %s.log" % (" ".join(command), tag))
+    values = {}
+    for name, pattern in METRICS.items():
+        match = pattern.search(result.stdout)
+        if not match:
+            sys.exit("no '%s' in the output of %s" % (name, program))
+        values[name] = float(match.group(1))
+    return values
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ns3-dir", default=".", help="ns-3 root, the working directory of the runs")
+    parser.add_argument("--profiles", default="debug,optimized", help="ns-3 build profiles")
+    parser.add_argument("--configure-args", default="", help="extra arguments of ./ns3 configure")
+    parser.add_argument("--no-build", action="store_true",
+                        help="reuse the executables kept in --out by a previous invocation")
+    parser.add_argument("--repeats", type=int, default=3, help="runs per profile")
+    parser.add_argument("--out", default="profile-bench", help="output directory")
+    parser.add_argument("extra", nargs="*", help="arguments passed to every run (after --)")
+    args = parser.parse_args()
+
+    args.ns3_dir = os.path.abspath(args.ns3_dir)
+    args.out = os.path.abspath(args.out)
+    os.makedirs(args.out, exist_ok=True)
+    report = {}
+    for profile in [p.strip() for p in args.profiles.split(",") if p.strip()]:
+        if args.no_build:
+            program = os.path.join(args.out, "exp01-%s" % profile)
+        else:
+            program = build(args.ns3_dir, profile, shlex.split(args.configure_args), args.out)
+        runs = [run(args.ns3_dir, program, profile, i, args.out, args.extra)
+                for i in range(args.repeats)]
+        report[profile] = {
+            "diagnostics": int(runs[0]["diagnostics"]),
+            "events": int(runs[0]["events"]),
+            "wall": statistics.median(r["wall"] for r in runs),
+            "eventsPerSecond": statistics.median(r["eventsPerSecond"] for r in runs),
+        }
+
+    with open(os.path.join(args.out, "bench.json"), "w") as f:
+        json.dump(report, f, indent=2)
+    print("%-10s %11s %12s %10s %14s" % ("profile", "diagnostics", "events", "wall (s)", "events/s"))
+    for profile, r in report.items():
+        print("%-10s %11d %12d %10.2f %14.0f"
+              % (profile, r["diagnostics"], r["events"], r["wall"], r["eventsPerSecond"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,74 @@
+#!/usr/bin/env python3
+# Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+"""
+Events per second of exp01_5glena_mobility with each event scheduler.
+
+Runs the built experiment --repeats times per --scheduler value on the same
+trace and reports the median "Events per second" and its ratio to the first
+scheduler. All the schedulers run the events in the same order, so the
+executed events and the received packets must match; the script stops if
+they do not. Run from the ns-3 root, after building the optimized profile:
+
+  ./scratch/one_v2x/sweep/exp01_scheduler_bench.py --schedulers map,wheel \\
+      -- --mobilityTrace=mob01.tcl
+"""
+
+import argparse
+import json
+import os
+import re
+import statistics
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from exp01_profile_bench import METRICS, run  # noqa: E402
+from exp01_sweep import find_program  # noqa: E402
+
+METRICS["rxPackets"] = re.compile(r"^Total Rx packets = (\d+)", re.M)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ns3-dir", default=".", help="ns-3 root, the working directory of the runs")
+    parser.add_argument("--program", help="experiment executable (default: the latest build)")
+    parser.add_argument("--schedulers", default="map,wheel",
+                        help="values of --scheduler, the first is the reference")
+    parser.add_argument("--repeats", type=int, default=3, help="runs per scheduler")
+    parser.add_argument("--out", default="scheduler-bench", help="output directory")
+    parser.add_argument("extra", nargs="*", help="arguments passed to every run (after --)")
+    args = parser.parse_args()
+
+    args.ns3_dir = os.path.abspath(args.ns3_dir)
+    args.out = os.path.abspath(args.out)
+    os.makedirs(args.out, exist_ok=True)
+    program = os.path.abspath(args.program) if args.program else find_program(args.ns3_dir)
+    report = {}
+    for scheduler in [s.strip() for s in args.schedulers.split(",") if s.strip()]:
+        extra = ["--scheduler=%s" % scheduler] + args.extra
+        runs = [run(args.ns3_dir, program, scheduler, i, args.out, extra)
+                for i in range(args.repeats)]
+        report[scheduler] = {
+            "events": int(runs[0]["events"]),
+            "rxPackets": int(runs[0]["rxPackets"]),
+            "wall": statistics.median(r["wall"] for r in runs),
+            "eventsPerSecond": statistics.median(r["eventsPerSecond"] for r in runs),
+        }
+
+    with open(os.path.join(args.out, "bench.json"), "w") as f:
+        json.dump(report, f, indent=2)
+    reference = next(iter(report.values()))
+    print("%-10s %12s %10s %10s %14s %8s"
+          % ("scheduler", "events", "rx", "wall (s)", "events/s", "speedup"))
+    for scheduler, r in report.items():
+        print("%-10s %12d %10d %10.2f %14.0f %8.2f"
+              % (scheduler, r["events"], r["rxPackets"], r["wall"], r["eventsPerSecond"],
+                 r["eventsPerSecond"] / reference["eventsPerSecond"]))
+    for scheduler, r in report.items():
+        if (r["events"], r["rxPackets"]) != (reference["events"], reference["rxPackets"]):
+            sys.exit("%s did not run the same simulation as the reference" % scheduler)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+# Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+"""
+Parameter sweep of exp01_5glena_mobility.
+
+Every point of the grid (run x ueCount x numerology x mcs x dataRateBe) is an
+independent ns-3 process. The processes are fed from a job queue to all local
+cores. Each job writes into its own directory under --out; a job is marked as
+done only when the simulation exits cleanly, so an interrupted sweep is
+resumed by simply running the same command again. At the end the per-job
+databases are merged into <out>/merged.db, with the grid parameters added as
+columns of every table.
+
+Build the scenario first (./ns3 build one_v2x) and run from the ns-3 root, e.g.:
+
+  ./scratch/one_v2x/sweep/exp01_sweep.py --runs 1-10 --ue-counts 50,100 \\
+      --numerologies 2,4 --mcs 14,20 --data-rates 16,64 -- --mobilityWindow=10
+"""
+
+import argparse
+import glob
+import itertools
+import json
+import os
+import signal
+import sqlite3
+import subprocess
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+DB_SUFFIX = "-nr-v2x-simple-demo.db"
+PARAMS = ("run", "ueCount", "numerology", "mcs", "dataRateBe")
+
+
+def parse_list(text, cast=int):
+    """'1-4,8' -> [1, 2, 3, 4, 8]"""
+    values = []
+    for item in text.split(","):
+        item = item.strip()
+        if not item:
+            continue
+        if "-" in item and cast is int:
+            first, last = item.split("-", 1)
+            values.extend(range(int(first), int(last) + 1))
+        else:
+            values.append(cast(item))
+    return values
+
+
+def find_program(ns3_dir):
+    pattern = os.path.join(ns3_dir, "build", "scratch", "one_v2x", "*exp01_5glena_mobility*")
+    candidates = [p for p in glob.glob(pattern) if os.access(p, os.X_OK) and os.path.isfile(p)]
+    if not candidates:
+        sys.exit("exp01_5glena_mobility not found under %s; build it or use --program" % pattern)
+    return max(candidates, key=os.path.getmtime)
+
+
+class Job:
+    def __init__(self, run, ue_count, numerology, mcs, data_rate):
+        self.params = {
+            "run": run,
+            "ueCount": ue_count,
+            "numerology": numerology,
+            "mcs": mcs,
+            "dataRateBe": data_rate,
+        }
+        self.tag = "run%d-ue%d-num%d-mcs%d-rate%g" % (run, ue_count, numerology, mcs, data_rate)
+
+    def directory(self, out):
+        return os.path.join(out, self.tag)
+
+    def marker(self, out):
+        return os.path.join(self.directory(out), "done.json")
+
+    def database(self, out):
+        return os.path.join(self.directory(out), self.tag + DB_SUFFIX)
+
+    def is_done(self, out):
+        return os.path.exists(self.marker(out))
+
+
+class Runner:
+    def __init__(self, args):
+        self.args = args
+        self.lock = threading.Lock()
+        self.children = set()
+        self.stopping = False
+
+    def command(self, job):
+        cmd = [self.args.program, "--seed=%d" % self.args.seed]
+        cmd += ["--%s=%s" % (name, job.params[name]) for name in PARAMS]
+        cmd += ["--simTag=" + job.tag, "--outputDir=" + job.directory(self.args.out) + "/"]
+        return cmd + self.args.extra
+
+    def execute(self, job):
+        directory = job.directory(self.args.out)
+        os.makedirs(directory, exist_ok=True)
+        # leftovers of an interrupted attempt would be appended to
+        if os.path.exists(job.database(self.args.out)):
+            os.remove(job.database(self.args.out))
+        start = time.time()
+        with open(os.path.join(directory, "stdout.log"), "w") as log:
+            with self.lock:
+                if self.stopping:
+                    return job, None, 0.0
+                child = subprocess.Popen(self.command(job), cwd=self.args.ns3_dir,
+                                         stdout=log, stderr=subprocess.STDOUT)
+                self.children.add(child)
+            code = child.wait()
+            with self.lock:
+                self.children.discard(child)
+        elapsed = time.time() - start
+        if code == 0:
+            marker = {"params": job.params, "seed": self.args.seed, "extra": self.args.extra,
+                      "wallTime": elapsed}
+            tmp = job.marker(self.args.out) + ".tmp"
+            with open(tmp, "w") as f:
+                json.dump(marker, f, indent=2)
+            os.replace(tmp, job.marker(self.args.out))
+        return job, code, elapsed
+
+    def stop(self):
+        with self.lock:
+            self.stopping = True
+            for child in self.children:
+                child.send_signal(signal.SIGTERM)
+
+    def run(self, jobs):
+        pending = [job for job in jobs if not job.is_done(self.args.out)]
+        print("%d jobs, %d already done, %d to run on %d workers"
+              % (len(jobs), len(jobs) - len(pending), len(pending), self.args.jobs))
+        failed = 0
+        with ThreadPoolExecutor(max_workers=self.args.jobs) as pool:
+            futures = [pool.submit(self.execute, job) for job in pending]
+            try:
+                for done, future in enumerate(as_completed(futures), 1):
+                    job, code, elapsed = future.result()
+                    if code is None:
+                        continue
+                    status = "ok" if code == 0 else "FAILED (exit %d, see %s/stdout.log)" % (
+                        code, job.directory(self.args.out))
+                    failed += code != 0
+                    print("[%d/%d] %s %s %.1f s" % (done, len(pending), job.tag, status, elapsed),
+                          flush=True)
+            except KeyboardInterrupt:
+                print("interrupted, stopping running jobs; run again to resume")
+                self.stop()
+                for future in futures:
+                    future.cancel()
+                raise
+        return failed
+
+
+def merge(out, jobs):
+    """Append the tables of every finished job to <out>/merged.db, once."""
+    merged = sqlite3.connect(os.path.join(out, "merged.db"))
+    merged.execute("CREATE TABLE IF NOT EXISTS sweepJobs (tag TEXT PRIMARY KEY, %s)"
+                   % ", ".join("%s NUMERIC" % name for name in PARAMS))
+    known = {row[0] for row in merged.execute("SELECT tag FROM sweepJobs")}
+    added = 0
+    for job in jobs:
+        if job.tag in known or not job.is_done(out) or not os.path.exists(job.database(out)):
+            continue
+        merged.execute("ATTACH DATABASE ? AS job", (job.database(out),))
+        with merged:
+            tables = [row[0] for row in merged.execute(
+                "SELECT name FROM job.sqlite_master WHERE type = 'table'")]
+            for table in tables:
+                columns = merged.execute("PRAGMA job.table_info(\"%s\")" % table).fetchall()
+                definition = ", ".join("\"%s\" %s" % (c[1], c[2]) for c in columns)
+                merged.execute("CREATE TABLE IF NOT EXISTS main.\"%s\" (sweepTag TEXT, %s, %s)"
+                               % (table, ", ".join("sweep_%s NUMERIC" % p for p in PARAMS),
+                                  definition))
+                names = ", ".join("\"%s\"" % c[1] for c in columns)
+                merged.execute(
+                    "INSERT INTO main.\"%s\" (sweepTag, %s, %s) SELECT ?, %s, %s FROM job.\"%s\""
+                    % (table, ", ".join("sweep_%s" % p for p in PARAMS), names,
+                       ", ".join("?" for _ in PARAMS), names, table),
+                    [job.tag] + [job.params[p] for p in PARAMS])
+            merged.execute("INSERT INTO sweepJobs VALUES (?, %s)" % ", ".join("?" for _ in PARAMS),
+                           [job.tag] + [job.params[p] for p in PARAMS])
+        merged.execute("DETACH DATABASE job")
+        added += 1
+    merged.close()
+    print("merged %d new jobs into %s" % (added, os.path.join(out, "merged.db")))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ns3-dir", default=".", help="ns-3 root, the working directory of the runs")
+    parser.add_argument("--program", help="exp01_5glena_mobility executable (default: search build/)")
+    parser.add_argument("--out", default="sweep-results", help="output directory")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count(), help="parallel processes")
+    parser.add_argument("--seed", type=int, default=1, help="RngSeedManager seed of all runs")
+    parser.add_argument("--runs", default="1", help="run numbers, e.g. 1-10")
+    parser.add_argument("--ue-counts", default="50")
+    parser.add_argument("--numerologies", default="4")
+    parser.add_argument("--mcs", default="14")
+    parser.add_argument("--data-rates", default="16", help="dataRateBe values in kb/s")
+    parser.add_argument("--merge-only", action="store_true", help="only merge finished jobs")
+    parser.add_argument("--dry-run", action="store_true", help="print the commands and exit")
+    parser.add_argument("extra", nargs="*", help="arguments passed to every run (after --)")
+    args = parser.parse_args()
+
+    args.out = os.path.abspath(args.out)
+    jobs = [Job(*point) for point in itertools.product(
+        parse_list(args.runs), parse_list(args.ue_counts), parse_list(args.numerologies),
+        parse_list(args.mcs), parse_list(args.data_rates, float))]
+    os.makedirs(args.out, exist_ok=True)
+
+    if not args.merge_only:
+        args.program = os.path.abspath(args.program or find_program(args.ns3_dir))
+        runner = Runner(args)
+        if args.dry_run:
+            for job in jobs:
+                print(" ".join(runner.command(job)))
+            return 0
+        try:
+            failed = runner.run(jobs)
+        except KeyboardInterrupt:
+            return 130
+        if failed:
+            print("%d jobs failed; they will be retried on the next invocation" % failed)
+    merge(args.out, jobs)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
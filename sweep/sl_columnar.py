@@ -0,0 +1,156 @@
+#!/usr/bin/env python3
+# Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+"""
+Reader of the .slc files written by exp01_5glena_mobility --outputFormat=columnar
+(columnar-table-writer.h).
+
+Only the requested columns are decoded; the others are skipped by seeking
+over their chunks. As a module:
+
+  from sl_columnar import read_columns
+  rx = read_columns("default-nr-v2x-simple-demo-psschRxUePhy.slc", ["timeMs", "tbler"])
+
+or, with pandas installed, read_frame(path, columns) for a DataFrame. From the
+command line it prints the schema and the row count, or dumps columns as CSV:
+
+  ./scratch/one_v2x/sweep/sl_columnar.py info  file.slc
+  ./scratch/one_v2x/sweep/sl_columnar.py csv   file.slc [column ...]
+"""
+
+import csv
+import struct
+import sys
+
+MAGIC = b"SLCOL1\0\0"
+INT64, DOUBLE, STRING = 1, 2, 3
+TYPE_NAMES = {INT64: "INT64", DOUBLE: "DOUBLE", STRING: "STRING"}
+
+
+def _varints(data, pos, count):
+    values = []
+    for _ in range(count):
+        value = shift = 0
+        while True:
+            byte = data[pos]
+            pos += 1
+            value |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                break
+            shift += 7
+        values.append(value)
+    return values, pos
+
+
+def _decode(kind, chunk, rows):
+    if kind == INT64:
+        deltas, _ = _varints(chunk, 0, rows)
+        values, previous = [], 0
+        for delta in deltas:
+            previous = (previous + ((delta >> 1) ^ -(delta & 1))) & 0xFFFFFFFFFFFFFFFF
+            values.append(previous - (1 << 64) if previous >> 63 else previous)
+        return values
+    if kind == DOUBLE:
+        xors, _ = _varints(chunk, 0, rows)
+        values, previous = [], 0
+        for xor in xors:
+            previous ^= xor
+            values.append(struct.unpack("<d", struct.pack("<Q", previous))[0])
+        return values
+    (size,), pos = _varints(chunk, 0, 1)
+    dictionary = []
+    for _ in range(size):
+        (length,), pos = _varints(chunk, pos, 1)
+        dictionary.append(chunk[pos:pos + length].decode())
+        pos += length
+    ids, _ = _varints(chunk, pos, rows)
+    return [dictionary[i] for i in ids]
+
+
+def read_schema(f):
+    """[(name, type), ...] of an open .slc file, positioned at the first row group."""
+    if f.read(8) != MAGIC:
+        raise ValueError("not an .slc file")
+    (count,) = struct.unpack("<I", f.read(4))
+    schema = []
+    for _ in range(count):
+        kind = f.read(1)[0]
+        length = shift = 0
+        while True:
+            byte = f.read(1)[0]
+            length |= (byte & 0x7F) << shift
+            if byte < 0x80:
+                break
+            shift += 7
+        schema.append((f.read(length).decode(), kind))
+    return schema
+
+
+def row_groups(f, schema, wanted):
+    """Yield (rows, {column: values}) for every complete row group."""
+    while True:
+        header = f.read(4)
+        if len(header) < 4:
+            return
+        (rows,) = struct.unpack("<I", header)
+        group = {}
+        for name, _ in schema:
+            chunk_header = f.read(5)
+            if len(chunk_header) < 5:
+                return
+            kind, size = chunk_header[0], struct.unpack("<I", chunk_header[1:])[0]
+            if name in wanted:
+                chunk = f.read(size)
+                if len(chunk) < size:
+                    return
+                group[name] = _decode(kind, chunk, rows)
+            else:
+                f.seek(size, 1)
+        yield rows, group
+
+
+def read_columns(path, columns=None):
+    """{column: [values]} of the requested columns (all by default)."""
+    with open(path, "rb") as f:
+        schema = read_schema(f)
+        names = [name for name, _ in schema]
+        wanted = set(columns or names)
+        unknown = wanted - set(names)
+        if unknown:
+            raise KeyError("no column %s in %s" % (", ".join(sorted(unknown)), path))
+        result = {name: [] for name in names if name in wanted}
+        for _, group in row_groups(f, schema, wanted):
+            for name, values in group.items():
+                result[name].extend(values)
+        return result
+
+
+def read_frame(path, columns=None):
+    """pandas.DataFrame of the requested columns."""
+    import pandas
+
+    return pandas.DataFrame(read_columns(path, columns))
+
+
+def main(argv):
+    if len(argv) < 3 or argv[1] not in ("info", "csv"):
+        sys.exit(__doc__)
+    if argv[1] == "info":
+        with open(argv[2], "rb") as f:
+            schema = read_schema(f)
+            rows = groups = 0
+            for count, _ in row_groups(f, schema, set()):
+                rows += count
+                groups += 1
+        for name, kind in schema:
+            print("%-20s %s" % (name, TYPE_NAMES.get(kind, kind)))
+        print("%d rows in %d row groups" % (rows, groups))
+        return 0
+    data = read_columns(argv[2], argv[3:] or None)
+    writer = csv.writer(sys.stdout)
+    writer.writerow(list(data))
+    writer.writerows(zip(*data.values()))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,2 @@
+// Stand-in: see scheduler.h
+#include "scheduler.h"
@@ -0,0 +1,142 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+/*
+ * Stand-ins for the parts of ns-3 that slot-wheel-scheduler.{h,cc} use, so
+ * that order_test.cpp builds without ns-3. Scheduler::Event, EventKey and
+ * its order are those of ns-3; TypeId and the attribute helpers do nothing.
+ */
+#ifndef STUB_NS3_SCHEDULER_H
+#define STUB_NS3_SCHEDULER_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+
+#define NS_LOG_COMPONENT_DEFINE(name)
+#define NS_OBJECT_ENSURE_REGISTERED(type)
+#define NS_LOG_FUNCTION(parameters)
+#define NS_ASSERT(condition) assert(condition)
+#define NS_ABORT_MSG_IF(condition, message)                                                        \
+    if (condition)                                                                                 \
+    {                                                                                              \
+        std::abort();                                                                              \
+    }
+
+namespace ns3
+{
+
+class EventImpl;
+
+class Time
+{
+  public:
+    explicit Time(int64_t ts = 0)
+        : m_ts(ts)
+    {
+    }
+
+    int64_t GetTimeStep() const
+    {
+        return m_ts;
+    }
+
+  private:
+    int64_t m_ts;
+};
+
+inline Time
+NanoSeconds(int64_t ns)
+{
+    return Time(ns);
+}
+
+inline Time
+TimeStep(int64_t ts)
+{
+    return Time(ts);
+}
+
+inline int
+TimeValue(Time)
+{
+    return 0;
+}
+
+template <typename T>
+int
+MakeTimeAccessor(T)
+{
+    return 0;
+}
+
+inline int
+MakeTimeChecker(Time)
+{
+    return 0;
+}
+
+class TypeId
+{
+  public:
+    explicit TypeId(const char*)
+    {
+    }
+
+    template <typename T>
+    TypeId& SetParent()
+    {
+        return *this;
+    }
+
+    TypeId& SetGroupName(const char*)
+    {
+        return *this;
+    }
+
+    template <typename T>
+    TypeId& AddConstructor()
+    {
+        return *this;
+    }
+
+    template <typename... Args>
+    TypeId& AddAttribute(Args...)
+    {
+        return *this;
+    }
+};
+
+class Scheduler
+{
+  public:
+    struct EventKey
+    {
+        uint64_t m_ts;
+        uint32_t m_uid;
+        uint32_t m_context;
+    };
+
+    struct Event
+    {
+        EventImpl* impl;
+        EventKey key;
+    };
+
+    virtual ~Scheduler() = default;
+    virtual void Insert(const Event& ev) = 0;
+    virtual bool IsEmpty() const = 0;
+    virtual Event PeekNext() const = 0;
+    virtual Event RemoveNext() = 0;
+    virtual void Remove(const Event& ev) = 0;
+};
+
+inline bool
+operator<(const Scheduler::EventKey& a, const Scheduler::EventKey& b)
+{
+    return a.m_ts < b.m_ts || (a.m_ts == b.m_ts && a.m_uid < b.m_uid);
+}
+
+} // namespace ns3
+
+#endif /* STUB_NS3_SCHEDULER_H */
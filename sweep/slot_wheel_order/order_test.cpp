@@ -0,0 +1,113 @@
+/*
+ * Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+ */
+/*
+ * Order test of SlotWheelScheduler against a std::set of the event keys,
+ * the order of the ns-3 map scheduler. Random inserts (in the current slot,
+ * on the slot grid, within the first wheel, within the second, and in the
+ * overflow map), RemoveNext calls and cancellations (Remove) are applied to
+ * both; every removed event, PeekNext and IsEmpty must agree. Built without
+ * ns-3 against the stubs of ns3/; run it with ../slot_wheel_order_test.py.
+ * The extension is .cpp so that the ns-3 scratch build does not take this
+ * directory for a program.
+ *
+ * Usage: order_test [trials] [operations per trial] [seed]
+ */
+#include "slot-wheel-scheduler.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace ns3;
+
+int
+main(int argc, char* argv[])
+{
+    int trials = argc > 1 ? std::atoi(argv[1]) : 20;
+    int operations = argc > 2 ? std::atoi(argv[2]) : 300000;
+    std::mt19937_64 rng(argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 1);
+    // Default SlotDuration of the scheduler, in time steps
+    const uint64_t slot = 62500;
+
+    for (int trial = 0; trial < trials; ++trial)
+    {
+        SlotWheelScheduler wheel;
+        std::set<Scheduler::EventKey> reference;
+        std::vector<Scheduler::EventKey> issued; // candidates for Remove
+        uint64_t now = 0;
+        uint32_t uid = 0;
+        for (int op = 0; op < operations; ++op)
+        {
+            int action = rng() % 10;
+            if (action < 5 || reference.empty())
+            {
+                uint64_t delay = 0;
+                switch (rng() % 6)
+                {
+                case 0: // now, in the current slot
+                    break;
+                case 1: // on the slot grid
+                    delay = (rng() % 4) * slot;
+                    break;
+                case 2: // first wheel
+                    delay = rng() % (slot * 300);
+                    break;
+                case 3: // second wheel
+                    delay = rng() % (slot * 256 * 300);
+                    break;
+                case 4: // within the slot
+                    delay = rng() % 1000;
+                    break;
+                default: // overflow map
+                    delay = rng() % (slot * 256 * 256 * 3);
+                }
+                Scheduler::EventKey key{now + delay, uid++, 0};
+                wheel.Insert(Scheduler::Event{nullptr, key});
+                reference.insert(key);
+                issued.push_back(key);
+            }
+            else if (action < 8)
+            {
+                Scheduler::Event next = wheel.RemoveNext();
+                Scheduler::EventKey expected = *reference.begin();
+                reference.erase(reference.begin());
+                if (next.key.m_uid != expected.m_uid || next.key.m_ts != expected.m_ts)
+                {
+                    std::printf("trial %d, operation %d: RemoveNext gave uid %u, expected %u\n",
+                                trial,
+                                op,
+                                next.key.m_uid,
+                                expected.m_uid);
+                    return 1;
+                }
+                now = next.key.m_ts;
+            }
+            else
+            {
+                size_t i = rng() % issued.size();
+                Scheduler::EventKey key = issued[i];
+                issued[i] = issued.back();
+                issued.pop_back();
+                if (reference.erase(key))
+                {
+                    wheel.Remove(Scheduler::Event{nullptr, key});
+                }
+            }
+            if (wheel.IsEmpty() != reference.empty())
+            {
+                std::printf("trial %d, operation %d: IsEmpty differs\n", trial, op);
+                return 1;
+            }
+            if (!reference.empty() && wheel.PeekNext().key.m_uid != reference.begin()->m_uid)
+            {
+                std::printf("trial %d, operation %d: PeekNext differs\n", trial, op);
+                return 1;
+            }
+        }
+    }
+    std::printf("%d trials of %d operations: same order\n", trials, operations);
+    return 0;
+}
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+# Author: Sérgio Vieira, sergio.vieira@ifce.edu.br - Instituto Federal de Educação, Ciência e Tecnologia do Ceará
+"""
+Order test of SlotWheelScheduler, runnable without ns-3.
+
+Builds slot_wheel_order/order_test.cpp with ../slot-wheel-scheduler.cc
+against the ns-3 stubs of slot_wheel_order/ns3, with assertions on, and
+runs it: random inserts, RemoveNext calls and cancellations must give the
+(timestamp, uid) order of a std::set, the order of the ns-3 map scheduler.
+A scheduler that reorders events would silently change the results of
+exp01, so run it after any change to the wheel:
+
+  ./scratch/one_v2x/sweep/slot_wheel_order_test.py
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "c++"), help="C++ compiler")
+    parser.add_argument("--trials", type=int, default=20, help="schedulers tested")
+    parser.add_argument("--operations", type=int, default=300000, help="operations per trial")
+    parser.add_argument("--seed", type=int, default=1, help="seed of the operations")
+    args = parser.parse_args()
+
+    with tempfile.TemporaryDirectory() as build:
+        binary = os.path.join(build, "order_test")
+        subprocess.run([args.cxx, "-std=c++17", "-O2", "-Wall",
+                        "-I", os.path.join(here, "slot_wheel_order"),
+                        "-I", os.path.dirname(here),
+                        os.path.join(here, "slot_wheel_order", "order_test.cpp"),
+                        os.path.join(os.path.dirname(here), "slot-wheel-scheduler.cc"),
+                        "-o", binary], check=True)
+        return subprocess.run([binary, str(args.trials), str(args.operations),
+                               str(args.seed)]).returncode
+
+
+if __name__ == "__main__":
+    sys.exit(main())